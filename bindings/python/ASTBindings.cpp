@@ -62,7 +62,15 @@ void registerAST(py::module_& m) {
         .def_property("queueTarget", &EvalContext::getQueueTarget, &EvalContext::setQueueTarget);
 
     py::class_<EvalContext::Frame>(evalCtx, "Frame")
-        .def_readonly("temporaries", &EvalContext::Frame::temporaries)
+        .def_property_readonly("temporaries",
+                               [](const EvalContext::Frame& self) {
+                                   std::map<const ValueSymbol*, ConstantValue> result;
+                                   for (size_t i = 0; i < self.symbols.size(); i++) {
+                                       if (auto symbol = self.symbols[i])
+                                           result.emplace(symbol, self.slots[i]);
+                                   }
+                                   return result;
+                               })
         .def_readonly("subroutine", &EvalContext::Frame::subroutine)
         .def_readonly("callLocation", &EvalContext::Frame::callLocation)
         .def_readonly("lookupLocation", &EvalContext::Frame::lookupLocation);
@@ -319,6 +319,8 @@ void registerNumeric(py::module_& m) {
                         return py::cast(*arg);
                     else if constexpr (std::is_same_v<T, ConstantValue::Union>)
                         return py::cast(*arg);
+                    else if constexpr (std::is_same_v<T, ConstantValue::DenseArray>)
+                        return py::cast(arg->unpack());
                     else
                         static_assert(always_false<T>::value, "Missing case");
                 },
@@ -7,8 +7,11 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <shared_mutex>
 
+#include "slang/ast/ASTContext.h"
 #include "slang/ast/OpaqueInstancePath.h"
 #include "slang/ast/Scope.h"
 #include "slang/diagnostics/Diagnostics.h"
@@ -34,6 +37,7 @@ class ConfigBlockSymbol;
 class DefinitionSymbol;
 class Expression;
 class GenericClassDefSymbol;
+class InstanceSymbol;
 class InterfacePortSymbol;
 class MethodPrototypeSymbol;
 class ModportSymbol;
@@ -46,6 +50,7 @@ class SubroutineSymbol;
 class Symbol;
 class SystemSubroutine;
 class ValueDriver;
+class ValueSymbol;
 struct AssertionInstanceDetails;
 struct ConfigRule;
 struct ResolvedConfig;
@@ -129,9 +134,14 @@ enum class SLANG_EXPORT CompilationFlags {
 
     /// Allow merging ANSI port declarations with nets and variables
     /// declared in the module body.
-    AllowMergingAnsiPorts = 1 << 14
+    AllowMergingAnsiPorts = 1 << 14,
+
+    /// Share elaboration work between instances that have identical definitions,
+    /// parameter values, and hierarchy overrides. Only one such instance body
+    /// will be fully elaborated; the others point to it via their canonical body.
+    EnableInstanceCaching = 1 << 15
 };
-SLANG_BITMASK(CompilationFlags, AllowMergingAnsiPorts)
+SLANG_BITMASK(CompilationFlags, EnableInstanceCaching)
 
 /// Contains various options that can control compilation behavior.
 struct SLANG_EXPORT CompilationOptions {
@@ -156,7 +166,7 @@ struct SLANG_EXPORT CompilationOptions {
 
     /// The maximum number of steps to allow when evaluating a constant expressions,
     /// to detect infinite loops.
-    uint32_t maxConstexprSteps = 100000;
+    uint32_t maxConstexprSteps = 1000000;
 
     /// The maximum number of frames in a callstack to display in diagnostics
     /// before abbreviating them.
@@ -501,6 +511,30 @@ public:
     /// These are later checked for correctness.
     void noteInstanceWithDefBind(const Symbol& instance);
 
+    /// Notes that a hierarchical reference crosses the boundary of the given instance body,
+    /// either reaching upward out of it or into it from elsewhere. Such bodies depend on
+    /// their surroundings and so are never shared via instance caching.
+    void noteHierarchicalReference(const InstanceBodySymbol& body);
+
+    /// Returns true if a hierarchical reference crossing the boundary of the given
+    /// instance body has been noted via noteHierarchicalReference().
+    bool hasHierarchicalReferences(const InstanceBodySymbol& body) const;
+
+    /// Notes that, with instance caching enabled, the body of @a instance is identical to
+    /// the previously elaborated @a canonical body and so was not elaborated itself.
+    /// Passing nullptr for @a canonical means the instance is no longer shared.
+    void noteSharedInstance(const InstanceSymbol& instance, const InstanceBodySymbol* canonical);
+
+    /// If instance caching is enabled and the given instance's body is identical to
+    /// some other instance's body, returns the canonical body that was fully
+    /// elaborated in its place. Otherwise returns nullptr.
+    const InstanceBodySymbol* getCanonicalBody(const InstanceSymbol& instance) const;
+
+    /// Notes that an instantiation of @a definition was elaborated in the given scope.
+    /// This is only tracked when instance caching is enabled, to account for the
+    /// instantiations that were skipped in shared bodies when coalescing diagnostics.
+    void noteInstantiation(const DefinitionSymbol& definition, const Scope& scope);
+
     /// Notes the presence of a DPI export directive. These will be checked for correctness
     /// but are otherwise unused by SystemVerilog code.
     void noteDPIExportDirective(const syntax::DPIExportSyntax& syntax, const Scope& scope);
@@ -580,6 +614,35 @@ public:
     /// be elaborated and any relevant diagnostics to be issued.
     void forceElaborate(const Symbol& symbol);
 
+    /// Looks up the cached result of an earlier call to the constant function
+    /// @a subroutine with the given argument values and evaluation flags.
+    /// Returns an empty value if there is none, or if the function referenced
+    /// parameters that aren't visible from a call made at @a lookupLocation.
+    ConstantValue findConstantCall(const SubroutineSymbol& subroutine, bitmask<EvalFlags> flags,
+                                   std::span<const ConstantValue> args,
+                                   LookupLocation lookupLocation);
+
+    /// Caches the result of a successful call to the constant function @a subroutine.
+    /// @a dependencies are the parameters and enum values referenced by the function
+    /// whose visibility depends on the call site. Results are only recorded while the
+    /// design is being elaborated, and only up to a fixed number of them.
+    void addConstantCall(const SubroutineSymbol& subroutine, bitmask<EvalFlags> flags,
+                         std::span<const ConstantValue> args,
+                         std::span<const ValueSymbol* const> dependencies,
+                         const ConstantValue& result);
+
+    /// Counts of lookups in the constant function call cache.
+    struct ConstantCallStats {
+        /// The number of calls that reused a cached result.
+        uint64_t hits = 0;
+
+        /// The number of calls that had to be evaluated.
+        uint64_t misses = 0;
+    };
+
+    /// Gets counts of lookups in the constant function call cache.
+    ConstantCallStats getConstantCallStats() const;
+
     /// Gets the default time scale to use when none is specified in the source code.
     std::optional<TimeScale> getDefaultTimeScale() const { return options.defaultTimeScale; }
 
@@ -734,6 +797,8 @@ private:
 
     const RootSymbol& getRoot(bool skipDefParamsAndBinds);
     void elaborate();
+    void countSharedInstances(std::span<const InstanceSymbol* const> sharedInstances);
+    size_t getInstanceMultiplicity(const Symbol& symbol);
     void insertDefinition(Symbol& symbol, const Scope& scope);
     void parseParamOverrides(flat_hash_map<std::string_view, const ConstantValue*>& results);
     void checkDPIMethods(std::span<const SubroutineSymbol* const> dpiImports);
@@ -872,6 +937,27 @@ private:
     // that have been supressed we need space to return *something* to the caller.
     Diagnostic tempDiag;
 
+    // A cached result of a call to a constant function.
+    struct ConstantCallEntry {
+        const SubroutineSymbol* subroutine;
+        bitmask<EvalFlags> flags;
+        std::vector<ConstantValue> args;
+        std::vector<const ValueSymbol*> dependencies;
+        ConstantValue result;
+    };
+
+    // Cached results of constant function calls, keyed by a hash of the function,
+    // evaluation flags, and argument values. Entries are only added until the design
+    // has been elaborated, with access guarded by the mutex since library users may
+    // evaluate constants from multiple threads. After that the cache is frozen and
+    // becomes read-only, so lookups no longer need to take the lock.
+    flat_hash_map<size_t, std::vector<ConstantCallEntry>> constantCallCache;
+    size_t numConstantCallEntries = 0;
+    std::atomic<bool> constantCallCacheFrozen = false;
+    mutable std::shared_mutex constantCallMutex;
+    std::atomic<uint64_t> constantCallHits = 0;
+    std::atomic<uint64_t> constantCallMisses = 0;
+
     std::optional<Diagnostics> cachedParseDiagnostics;
     std::optional<Diagnostics> cachedSemanticDiagnostics;
     std::optional<Diagnostics> cachedAllDiagnostics;
@@ -937,6 +1023,22 @@ private:
     // This is pretty rare and only used for checking of type params.
     flat_hash_map<const DefinitionSymbol*, std::vector<const Symbol*>> instancesWithDefBinds;
 
+    // State for instance caching: bodies that can't be shared due to hierarchical
+    // references, the canonical body of each shared instance, and every elaborated
+    // instantiation along with the scope containing it.
+    flat_hash_set<const InstanceBodySymbol*> bodiesWithHierarchicalRefs;
+    flat_hash_map<const InstanceSymbol*, const InstanceBodySymbol*> canonicalBodies;
+    std::vector<std::pair<const DefinitionSymbol*, const Scope*>> cachedInstantiations;
+
+    // Computed after elaboration when instance caching shared some bodies: the
+    // instances sharing each canonical body, the number of instances each body
+    // stands for, and the number of instantiations of each definition that were
+    // skipped in shared bodies. Used for coalescing diagnostics.
+    flat_hash_map<const InstanceBodySymbol*, std::vector<const InstanceSymbol*>>
+        sharedInstanceBodies;
+    flat_hash_map<const InstanceBodySymbol*, size_t> instanceMultiplicity;
+    flat_hash_map<const DefinitionSymbol*, size_t> elidedInstanceCounts;
+
     // The name map for extern module/interface/program/primitive declarations.
     // The key is a combination of definition name + the scope in which it was declared.
     flat_hash_map<std::tuple<std::string_view, const Scope*>, const syntax::SyntaxNode*>
@@ -7,12 +7,14 @@
 //------------------------------------------------------------------------------
 #pragma once
 
-#include <map>
+#include <deque>
 
 #include "slang/ast/ASTContext.h"
 #include "slang/numeric/ConstantValue.h"
 #include "slang/text/SourceLocation.h"
+#include "slang/util/Hash.h"
 #include "slang/util/ScopeGuard.h"
+#include "slang/util/SmallVector.h"
 
 namespace slang::ast {
 
@@ -35,9 +37,15 @@ public:
 
     /// Represents a single frame in the call stack.
     struct Frame {
-        /// A set of temporary values materialized within the stack frame.
-        /// Uses a map so that the values don't move around in memory.
-        std::map<const ValueSymbol*, ConstantValue> temporaries;
+        /// The symbols of the temporary values materialized within the stack frame,
+        /// in the order they were created. The value of each one is stored in the
+        /// slot with the same index in @a slots. Symbols of locals that have since
+        /// been deleted are set to nullptr.
+        SmallVector<const ValueSymbol*> symbols;
+
+        /// Storage for the temporary values materialized within the stack frame.
+        /// Uses a deque so that the values don't move around in memory.
+        std::deque<ConstantValue> slots;
 
         /// The function that is being executed in this frame, if any.
         const SubroutineSymbol* subroutine = nullptr;
@@ -47,6 +55,58 @@ public:
 
         /// The lookup location of the function call site.
         LookupLocation lookupLocation;
+
+        /// Parameters and enum values referenced by the function whose visibility
+        /// was checked against @a lookupLocation. A cached result of the call can
+        /// only be reused by call sites from which all of them are visible.
+        SmallVector<const ValueSymbol*> callSiteDependencies;
+
+        /// Gets the index of the slot holding the value of the given symbol,
+        /// or -1 if the symbol doesn't have a value in this frame.
+        ptrdiff_t findSlot(const ValueSymbol* symbol) const {
+            if (symbols.size() > MaxScannedSlots) {
+                auto it = slotIndex.find(symbol);
+                return it == slotIndex.end() ? -1 : ptrdiff_t(it->second);
+            }
+
+            // Search from the most recently created locals, which tend to be
+            // the innermost variables of loops and blocks.
+            for (size_t i = symbols.size(); i > 0; i--) {
+                if (symbols[i - 1] == symbol)
+                    return ptrdiff_t(i - 1);
+            }
+            return -1;
+        }
+
+        /// Creates a new slot for the given symbol and returns its storage.
+        ConstantValue& addSlot(const ValueSymbol* symbol) {
+            symbols.push_back(symbol);
+            if (symbols.size() == MaxScannedSlots + 1) {
+                for (size_t i = 0; i < symbols.size(); i++) {
+                    if (symbols[i])
+                        slotIndex[symbols[i]] = i;
+                }
+            }
+            else if (symbols.size() > MaxScannedSlots) {
+                slotIndex[symbol] = symbols.size() - 1;
+            }
+            return slots.emplace_back();
+        }
+
+        /// Clears the slot at the given index after its local has been deleted.
+        /// The slot itself stays in place so that the others don't move.
+        void clearSlot(size_t index) {
+            if (symbols.size() > MaxScannedSlots)
+                slotIndex.erase(symbols[index]);
+            symbols[index] = nullptr;
+            slots[index] = nullptr;
+        }
+
+    private:
+        // Frames with only a few locals are searched linearly, which is faster
+        // than hashing; larger ones also keep an index from symbol to slot.
+        static constexpr size_t MaxScannedSlots = 16;
+        flat_hash_map<const ValueSymbol*, size_t> slotIndex;
     };
 
     /// Constructs a new EvalContext instance.
@@ -81,6 +141,10 @@ public:
     /// Pop the active frame from the call stack.
     void popFrame();
 
+    /// Records that the function executing in the current frame referenced the
+    /// given symbol, whose visibility depends on the call site.
+    void addCallSiteDependency(const ValueSymbol& symbol);
+
     /// Pushes an lvalue onto the stack for later reference during evaluation.
     /// NOTE: the lvalue storage must remain alive for as long as it remains
     /// on the eval context's lvalue stack.
@@ -161,6 +225,9 @@ public:
     /// Gets the set of diagnostics that have been produced during constant evaluation.
     Diagnostics getAllDiagnostics() const;
 
+    /// Gets the number of diagnostics of any severity produced so far.
+    size_t getDiagnosticCount() const { return diags.size() + warnings.size(); }
+
     /// Records a diagnostic under the current evaluation context.
     Diagnostic& addDiag(DiagCode code, SourceLocation location);
 
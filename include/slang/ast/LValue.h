@@ -85,7 +85,8 @@ public:
     void addArrayLookup(ConstantValue&& index, ConstantValue&& defaultValue);
 
 private:
-    ConstantValue* resolveInternal(std::optional<ConstantRange>& range);
+    ConstantValue* resolveInternal(std::optional<ConstantRange>& range,
+                                   std::optional<size_t>& denseIndex);
 
     // A selection of a range of bits from an integral value.
     struct BitSlice {
@@ -62,6 +62,17 @@ public:
     ConstantValue evalImpl(EvalContext& context) const;
     LValue evalLValueImpl(EvalContext& context) const;
 
+    /// If the expression refers to a local variable in the current stack frame
+    /// of @a context, returns a pointer to the variable's storage so that it can be
+    /// read without making a copy of its value. The pointed-to value is bad if the
+    /// variable can't be referenced here, in which case an error has been issued.
+    /// Returns nullptr if the expression doesn't refer to a local variable.
+    const ConstantValue* evalLocal(EvalContext& context) const;
+
+    /// Checks whether the given parameter or enum value, referenced from within
+    /// a constant function, can be used by a call made at @a lookupLocation.
+    static bool isVisibleFromCallSite(const ValueSymbol& symbol, LookupLocation lookupLocation);
+
     static bool isKind(ExpressionKind kind) { return kind == ExpressionKind::NamedValue; }
 
 private:
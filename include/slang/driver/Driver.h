@@ -13,6 +13,7 @@
 #include "slang/text/SourceManager.h"
 #include "slang/util/Bag.h"
 #include "slang/util/CommandLine.h"
+#include "slang/util/Function.h"
 #include "slang/util/LanguageVersion.h"
 #include "slang/util/OS.h"
 #include "slang/util/Util.h"
@@ -115,6 +116,12 @@ public:
         /// The number of threads to use for parsing.
         std::optional<uint32_t> numThreads;
 
+        /// If true, source files are memory mapped instead of being read into memory.
+        std::optional<bool> mmapSources;
+
+        /// A directory in which to cache parsed syntax trees between runs.
+        std::optional<std::string> syntaxCacheDir;
+
         /// @}
         /// @name Compilation
         /// @{
@@ -205,6 +212,10 @@ public:
         /// The maximum number of errors to print before giving up.
         std::optional<uint32_t> errorLimit;
 
+        /// If true, a summary of the time and memory used by each phase of
+        /// compilation should be printed via @a reportStats.
+        std::optional<bool> showStats;
+
         /// A list of warning options that will be passed to the DiagnosticEngine.
         std::vector<std::string> warningOptions;
 
@@ -309,6 +320,17 @@ public:
     /// @returns true if compilation succeeded and false if errors were encountered.
     [[nodiscard]] bool reportCompilation(ast::Compilation& compilation, bool quiet);
 
+    /// @brief Runs @a func as a phase of compilation called @a name.
+    ///
+    /// The time and memory used by the phase are recorded for @a reportStats.
+    void measurePhase(std::string_view name, function_ref<void()> func);
+
+    /// @brief Prints the time and memory used by each phase run via @a measurePhase.
+    ///
+    /// This is followed by counts of the tokens and syntax nodes in @a syntaxTrees
+    /// and, if @a compilation is provided, of the symbols in its design.
+    void reportStats(ast::Compilation* compilation = nullptr);
+
 private:
     bool parseUnitListing(std::string_view text);
     void addLibraryFiles(std::string_view pattern);
@@ -318,6 +340,14 @@ private:
     void printError(const std::string& message);
     void printWarning(const std::string& message);
 
+    struct PhaseStats {
+        std::string name;
+        double wallTime;
+        double cpuTime;
+        size_t peakMemory;
+    };
+    std::vector<PhaseStats> phaseStats;
+
     bool anyFailedLoads = false;
     flat_hash_set<std::filesystem::path> activeCommandFiles;
 };
@@ -49,6 +49,10 @@ struct SLANG_EXPORT SourceOptions {
 
     /// If true, library files will inherit macro definitions from primary source files.
     bool librariesInheritMacros;
+
+    /// If set, parsed syntax trees for individual files will be cached in
+    /// this directory and reused by later runs when the file hasn't changed.
+    std::filesystem::path syntaxCacheDir;
 };
 
 /// @brief Handles loading and parsing of groups of source files
@@ -210,6 +214,9 @@ private:
                        const std::filesystem::path& basePath);
     LoadResult loadAndParse(const FileEntry& fileEntry, const Bag& optionBag,
                             const SourceOptions& srcOptions, uint64_t fileSortKey = UINT64_MAX);
+    std::shared_ptr<syntax::SyntaxTree> parseCached(const SourceBuffer& buffer,
+                                                    const Bag& optionBag,
+                                                    const std::filesystem::path& cacheDir);
     void addError(const std::filesystem::path& path, std::error_code ec);
 
     SourceManager& sourceManager;
@@ -20,6 +20,7 @@
 namespace slang {
 
 struct AssociativeArray;
+struct SVDenseArray;
 struct SVQueue;
 struct SVUnion;
 
@@ -61,9 +62,11 @@ public:
     using Map = CopyPtr<AssociativeArray>;
     using Queue = CopyPtr<SVQueue>;
     using Union = CopyPtr<SVUnion>;
+    using DenseArray = CopyPtr<SVDenseArray>;
 
-    using Variant = std::variant<std::monostate, SVInt, real_t, shortreal_t, NullPlaceholder,
-                                 Elements, std::string, Map, Queue, Union, UnboundedPlaceholder>;
+    using Variant =
+        std::variant<std::monostate, SVInt, real_t, shortreal_t, NullPlaceholder, Elements,
+                     std::string, Map, Queue, Union, UnboundedPlaceholder, DenseArray>;
 
     ConstantValue() = default;
     ConstantValue(nullptr_t) {}
@@ -95,6 +98,11 @@ public:
     ConstantValue(const SVUnion& unionVal) : value(Union(unionVal)) {}
     ConstantValue(SVUnion&& unionVal) : value(Union(std::move(unionVal))) {}
 
+    ConstantValue(const DenseArray& dense) : value(dense) {}
+    ConstantValue(DenseArray&& dense) : value(std::move(dense)) {}
+    ConstantValue(const SVDenseArray& dense) : value(DenseArray(dense)) {}
+    ConstantValue(SVDenseArray&& dense) : value(DenseArray(std::move(dense))) {}
+
     bool bad() const { return std::holds_alternative<std::monostate>(value); }
     explicit operator bool() const { return !bad(); }
 
@@ -108,6 +116,7 @@ public:
     bool isMap() const { return std::holds_alternative<Map>(value); }
     bool isQueue() const { return std::holds_alternative<Queue>(value); }
     bool isUnion() const { return std::holds_alternative<Union>(value); }
+    bool isDenseArray() const { return std::holds_alternative<DenseArray>(value); }
 
     bool isContainer() const { return isUnpacked() || isQueue() || isMap(); }
 
@@ -142,6 +151,11 @@ public:
     Union unionVal() && { return std::get<Union>(std::move(value)); }
     Union unionVal() const&& { return std::get<Union>(std::move(value)); }
 
+    DenseArray& denseArray() & { return std::get<DenseArray>(value); }
+    const DenseArray& denseArray() const& { return std::get<DenseArray>(value); }
+    DenseArray denseArray() && { return std::get<DenseArray>(std::move(value)); }
+    DenseArray denseArray() const&& { return std::get<DenseArray>(std::move(value)); }
+
     ConstantValue getSlice(int32_t upper, int32_t lower, const ConstantValue& defaultValue) const;
 
     Variant& getVariant() { return value; }
@@ -207,6 +221,86 @@ struct SLANG_EXPORT SVUnion {
     std::optional<uint32_t> activeMember;
 };
 
+/// Represents a fixed-size unpacked array of integral elements, for use during constant
+/// evaluation. Instead of holding a separate ConstantValue per element, all elements are
+/// packed into one contiguous buffer of words: a plane of value bits followed, for
+/// four-state element types, by a plane of unknown bits. Narrow elements share words,
+/// while elements wider than a word each take a whole number of words.
+struct SLANG_EXPORT SVDenseArray {
+    /// An iterator over the elements of the array. Elements are unpacked into
+    /// storage owned by the iterator, so only read access is possible.
+    class const_iterator : public iterator_facade<const_iterator> {
+    public:
+        const_iterator() = default;
+        const_iterator(const SVDenseArray& array, size_t index) : array(&array), index(index) {}
+
+        const ConstantValue& dereference() const {
+            current = array->get(index);
+            return current;
+        }
+
+        void increment() { index++; }
+        void decrement() { index--; }
+        bool equals(const const_iterator& other) const {
+            return array == other.array && index == other.index;
+        }
+
+    private:
+        const SVDenseArray* array = nullptr;
+        size_t index = 0;
+        mutable ConstantValue current;
+    };
+
+    /// Constructs an array of @a count copies of the @a initial element value.
+    /// The width and signedness of @a initial determine those of every element.
+    SVDenseArray(size_t count, const SVInt& initial, bool isFourState);
+
+    /// Determines whether the given elements can be stored in a dense array: they must
+    /// all be integers of the same width.
+    static bool canPack(std::span<const ConstantValue> elements);
+
+    /// Packs the given elements, which must satisfy @a canPack, into a new dense array.
+    static SVDenseArray pack(std::span<const ConstantValue> elements, bool isFourState);
+
+    /// Gets the number of elements in the array.
+    size_t size() const { return count; }
+
+    /// Gets the bit width of each element.
+    bitwidth_t elementWidth() const { return width; }
+
+    /// Determines whether any element has unknown bits.
+    bool hasUnknown() const;
+
+    /// Gets the value of the element at the given index.
+    SVInt get(size_t index) const;
+
+    /// Sets the value of the element at the given index. The value must be
+    /// the same width as the array's elements.
+    void set(size_t index, const SVInt& value);
+
+    /// Replaces the contents of the array with the given elements, if they have the
+    /// same number and width of elements as this array.
+    /// @returns true if the elements were stored, and false if they are incompatible.
+    bool assign(std::span<const ConstantValue> elements);
+
+    /// Unpacks all elements into a general element list.
+    ConstantValue::Elements unpack() const;
+
+    const_iterator begin() const { return const_iterator(*this, 0); }
+    const_iterator end() const { return const_iterator(*this, count); }
+
+private:
+    uint64_t* unknownPlane() { return words.data() + planeWords; }
+    const uint64_t* unknownPlane() const { return words.data() + planeWords; }
+
+    std::vector<uint64_t> words;
+    size_t count = 0;
+    size_t planeWords = 0;
+    bitwidth_t width = 0;
+    bool signFlag = false;
+    bool fourState = false;
+};
+
 /// An iterator for child elements in a ConstantValue, if it represents an
 /// array, map, or queue.
 template<bool IsConst>
@@ -218,11 +312,16 @@ public:
     using AssocIt =
         std::conditional_t<IsConst, AssociativeArray::const_iterator, AssociativeArray::iterator>;
     using QueueIt = std::conditional_t<IsConst, SVQueue::const_iterator, SVQueue::iterator>;
-    using VarType = std::variant<ElemIt, AssocIt, QueueIt>;
+    using DenseIt = SVDenseArray::const_iterator;
+    using VarType = std::conditional_t<IsConst, std::variant<ElemIt, AssocIt, QueueIt, DenseIt>,
+                                       std::variant<ElemIt, AssocIt, QueueIt>>;
 
     CVIterator(ElemIt&& it) : current(std::move(it)) {}
     CVIterator(AssocIt&& it) : current(std::move(it)) {}
     CVIterator(QueueIt&& it) : current(std::move(it)) {}
+    CVIterator(DenseIt&& it)
+        requires IsConst
+        : current(std::move(it)) {}
     CVIterator(const CVIterator& other) : current(other.current) {}
 
     TRef dereference() const {
@@ -274,6 +373,9 @@ CVIterator<IsConst> begin(TValue& cv) {
                                std::is_same_v<T, ConstantValue::Queue>) {
                 return arg->begin();
             }
+            else if constexpr (IsConst && std::is_same_v<T, ConstantValue::DenseArray>) {
+                return arg->begin();
+            }
             else {
                 SLANG_UNREACHABLE;
             }
@@ -294,6 +396,9 @@ CVIterator<IsConst> end(TValue& cv) {
                                std::is_same_v<T, ConstantValue::Queue>) {
                 return arg->end();
             }
+            else if constexpr (IsConst && std::is_same_v<T, ConstantValue::DenseArray>) {
+                return arg->end();
+            }
             else {
                 SLANG_UNREACHABLE;
             }
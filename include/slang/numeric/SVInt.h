@@ -7,6 +7,7 @@
 //-----------------------------------------------------------------------------
 #pragma once
 
+#include <algorithm>
 #include <bit>
 #include <climits>
 #include <concepts>
@@ -145,9 +146,11 @@ public:
 /// states of X and Z.
 ///
 /// Small integer values that fit within 64 bits are kept in a simple native integer. Otherwise,
-/// space is allocated on the heap. If there are any unknown bits in the number, an extra set of
-/// words are allocated adjacent in memory. The bits in these extra words indicate whether the
-/// corresponding bits in the low words are unknown or normal.
+/// the value is stored in a set of words. If there are any unknown bits in the number, an extra
+/// set of words are stored adjacent in memory. The bits in these extra words indicate whether the
+/// corresponding bits in the low words are unknown or normal. Values that need only two words
+/// (2-state values up to 128 bits and 4-state values up to 64 bits) keep them inside the object;
+/// anything larger is allocated on the heap.
 ///
 class SLANG_EXPORT SVInt : SVIntStorage {
 public:
@@ -208,10 +211,7 @@ public:
         initSlowCase(bytes);
     }
 
-    ~SVInt() {
-        if (!isSingleWord())
-            delete[] pVal;
-    }
+    ~SVInt() { freeWords(pVal, getNumWords()); }
 
     /// Copy construct.
     SVInt(const SVInt& other) : SVInt(static_cast<const SVIntStorage&>(other)) {}
@@ -228,6 +228,8 @@ public:
         SVIntStorage(other.bitWidth, other.signFlag, other.unknownFlag) {
         if (isSingleWord())
             val = other.val;
+        else if (getNumWords() <= MaxInlineWords)
+            pVal = copyInlineWords(other);
         else
             pVal = std::exchange(other.pVal, nullptr);
     }
@@ -432,16 +434,21 @@ public:
         if (this == &rhs)
             return *this;
 
-        if (!isSingleWord())
-            delete[] pVal;
+        freeWords(pVal, getNumWords());
 
         val = rhs.val;
         bitWidth = rhs.bitWidth;
         signFlag = rhs.signFlag;
         unknownFlag = rhs.unknownFlag;
 
-        // prevent the other object from releasing memory
-        rhs.pVal = nullptr;
+        if (!isSingleWord() && getNumWords() <= MaxInlineWords) {
+            // inline words are copied, not stolen
+            pVal = copyInlineWords(rhs);
+        }
+        else {
+            // prevent the other object from releasing memory
+            rhs.pVal = nullptr;
+        }
         return *this;
     }
 
@@ -519,6 +526,11 @@ public:
     static SVInt fromDouble(bitwidth_t bits, double value, bool isSigned, bool round = true);
     static SVInt fromFloat(bitwidth_t bits, float value, bool isSigned, bool round = true);
 
+    /// Construct from raw words of value data and, optionally, an equal number of words
+    /// marking which bits are unknown. This is the same layout returned by @a getRawPtr.
+    static SVInt fromRawWords(bitwidth_t bits, bool isSigned, std::span<const uint64_t> value,
+                              std::span<const uint64_t> unknown = {});
+
     /// Evaluates a conditional expression; i.e. condition ? left : right
     static SVInt conditional(const SVInt& condition, const SVInt& lhs, const SVInt& rhs);
 
@@ -567,10 +579,44 @@ public:
     static constexpr bitwidth_t DefaultStringAbbreviationThresholdBits = 128;
 
 private:
+    // The largest number of words that are stored inline instead of on the heap.
+    static constexpr uint32_t MaxInlineWords = 2;
+
+    // Storage for values that need more than one word but no more than MaxInlineWords;
+    // pVal points here for those values. Unused for all other values.
+    uint64_t inlineWords[MaxInlineWords];
+
     // fast internal constructors to just set fields on new values
     SVInt(uint64_t* data, bitwidth_t bits, bool signFlag, bool unknownFlag) :
         SVIntStorage(data, bits, signFlag, unknownFlag) {}
 
+    // Gets storage for a value made up of the given number of words (which must be
+    // more than one), using the inline words if they are big enough.
+    uint64_t* allocWords(uint32_t numWords) {
+        return numWords <= MaxInlineWords ? inlineWords : new uint64_t[numWords];
+    }
+
+    // Same as allocWords, but the returned words are zero cleared.
+    uint64_t* allocZeroedWords(uint32_t numWords) {
+        if (numWords <= MaxInlineWords) {
+            std::ranges::fill(inlineWords, 0);
+            return inlineWords;
+        }
+        return new uint64_t[numWords]();
+    }
+
+    // Copies the inline words of another value into this one and returns them.
+    uint64_t* copyInlineWords(const SVInt& other) {
+        std::ranges::copy(other.inlineWords, inlineWords);
+        return inlineWords;
+    }
+
+    // Frees storage for the given number of words previously returned by allocWords.
+    static void freeWords(uint64_t* words, uint32_t numWords) {
+        if (numWords > MaxInlineWords)
+            delete[] words;
+    }
+
     static SVInt allocUninitialized(bitwidth_t bits, bool signFlag, bool unknownFlag);
     static SVInt allocZeroed(bitwidth_t bits, bool signFlag, bool unknownFlag);
 
@@ -610,6 +656,17 @@ private:
 
     static SVInt fromDecimalDigits(bitwidth_t bits, bool isSigned, std::span<logic_t const> digits);
 
+    // Large values are converted to and from decimal by splitting them in half
+    // by powers of ten, which are kept in this table.
+    struct DecimalPowers;
+
+    static SVInt fromDecimalDigits(DecimalPowers& powers, std::span<logic_t const> digits);
+    static SVInt fromDecimalChunk(std::span<logic_t const> digits);
+    static void writeDecimalDigits(SmallVectorBase<char>& buffer, DecimalPowers& powers,
+                                   uint32_t level, SVInt value, size_t minDigits);
+    static void writeDecimalChunk(SmallVectorBase<char>& buffer, const SVInt& value,
+                                  size_t minDigits);
+
     static SVInt fromPow2Digits(bitwidth_t bits, bool isSigned, bool anyUnknown, uint32_t radix,
                                 uint32_t shift, std::span<logic_t const> digits);
 
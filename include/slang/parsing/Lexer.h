@@ -33,6 +33,19 @@ struct SLANG_EXPORT LexerOptions {
     LanguageVersion languageVersion = LanguageVersion::Default;
 };
 
+/// A token produced by a Lexer, along with the offsets in its source text where
+/// lexing of the token (including its leading trivia) started and ended.
+struct SLANG_EXPORT LexedToken {
+    /// The token that was lexed.
+    Token token;
+
+    /// The offset at which lexing of the token started.
+    uint32_t startOffset;
+
+    /// The offset just past the end of the token.
+    uint32_t endOffset;
+};
+
 /// Possible encodings for encrypted text used in a pragma protect region.
 enum class SLANG_EXPORT ProtectEncoding { UUEncode, Base64, QuotedPrintable, Raw };
 
@@ -64,6 +77,12 @@ public:
     /// Lexes a token that contains encoded text as part of a protected envelope.
     Token lexEncodedText(ProtectEncoding encoding, uint32_t expectedBytes, bool singleLine);
 
+    /// Provides tokens previously lexed from the same source text with the given
+    /// keyword version. Whenever the next token in the list starts at the lexer's
+    /// current position it is replayed, with its location adjusted to refer to this
+    /// lexer's buffer, instead of lexing that part of the text again.
+    void setPrelexedTokens(std::span<const LexedToken> tokens, KeywordVersion keywordVersion);
+
     /// Returns the library with which the lexer's source buffer is associated.
     const SourceLibrary* getLibrary() const { return library; }
 
@@ -87,7 +106,10 @@ private:
     Lexer(BufferID bufferId, std::string_view source, const char* startPtr, BumpAllocator& alloc,
           Diagnostics& diagnostics, LexerOptions options);
 
+    friend class TokenCache;
+
     Token lexToken(KeywordVersion keywordVersion);
+    Token replayToken(KeywordVersion keywordVersion);
     Token lexEscapeSequence(bool isMacroName);
     Token lexNumericLiteral();
     Token lexDollarSign();
@@ -160,6 +182,11 @@ private:
     SmallVector<char> stringBuffer;
 
     const SourceLibrary* library = nullptr;
+
+    // previously lexed tokens to replay, if any
+    std::span<const LexedToken> prelexedTokens;
+    size_t prelexedIndex = 0;
+    KeywordVersion prelexedVersion = KeywordVersion::v1800_2023;
 };
 
 } // namespace slang::parsing
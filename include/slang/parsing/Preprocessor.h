@@ -32,6 +32,8 @@ struct PragmaExpressionSyntax;
 
 namespace slang::parsing {
 
+class TokenCache;
+
 /// Contains various options that can control preprocessing behavior.
 struct SLANG_EXPORT PreprocessorOptions {
     /// The maximum depth of the include stack; further attempts to include
@@ -57,6 +59,11 @@ struct SLANG_EXPORT PreprocessorOptions {
 
     /// A set of preprocessor directives to be ignored.
     flat_hash_set<std::string_view> ignoreDirectives;
+
+    /// An optional cache of lexed tokens for included files, which can be
+    /// shared by all of the preprocessors working on a set of syntax trees
+    /// so that commonly included headers are only lexed once.
+    std::shared_ptr<TokenCache> tokenCache;
 };
 
 /// Preprocessor - Interface between lexer and parser
@@ -156,6 +163,13 @@ private:
     Token nextRaw();
     void popSource();
 
+    // Include guard detection and handling
+    void beginIncludeGuard(Token directive,
+                           const syntax::ConditionalDirectiveExpressionSyntax& expr);
+    void endIncludeGuardBranch(Token directive);
+    void invalidateIncludeGuard();
+    bool shouldSkipInclude(const char* fileText) const;
+
     // directive handling methods
     Token handleDirectives(Token token);
     Trivia handleIncludeDirective(Token directive);
@@ -414,6 +428,33 @@ private:
     // have been marked `pragma once so that we avoid trying to include them more than once.
     flat_hash_set<const char*> includeOnceHeaders;
 
+    // Tracks whether the file at each level of the lexer stack is entirely wrapped in a
+    // single `ifndef include guard, i.e. the `ifndef is the first thing in the file
+    // and its matching `endif is the last.
+    struct IncludeGuardState {
+        enum Kind : uint8_t { Start, InGuard, AfterGuard, NotGuarded };
+
+        const char* fileText = nullptr;
+        BufferID buffer;
+        std::string_view macroName;
+        size_t branchIndex = 0;
+        Kind kind = Start;
+    };
+    SmallVector<IncludeGuardState, 2> includeGuardStack;
+
+    // A map of files (identified by a pointer to the start of their text buffer) that are
+    // known to be entirely wrapped in an include guard to the name of the guard macro.
+    // Including such a file again while the macro is defined is skipped.
+    flat_hash_map<const char*, std::string_view> includeGuardMacros;
+
+    // A cache of the files found by previous include directives, keyed by everything
+    // that affects the lookup: the include path, whether it's a system include,
+    // the text of the including file, and the current source library. This lets us
+    // skip guarded files without going back to the file system to find them again.
+    flat_hash_map<std::tuple<std::string_view, bool, const char*, const SourceLibrary*>,
+                  const char*>
+        includeLookupCache;
+
     /// Various state set by preprocessor directives.
     std::vector<KeywordVersion> keywordVersionStack;
     std::optional<TimeScale> activeTimeScale;
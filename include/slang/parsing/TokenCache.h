@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------------
+//! @file TokenCache.h
+//! @brief Thread-safe cache of lexed tokens for shared source files
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "slang/parsing/Lexer.h"
+#include "slang/util/BumpAllocator.h"
+#include "slang/util/Hash.h"
+
+namespace slang::parsing {
+
+/// @brief A thread-safe cache of the tokens lexed from source files.
+///
+/// Headers are often included by many different syntax trees, each with their
+/// own Preprocessor, and would normally be lexed from scratch by each of them.
+/// When a cache is provided via PreprocessorOptions, included files are instead
+/// lexed once into memory owned by the cache and then replayed by each
+/// preprocessor that includes them.
+///
+/// Files whose lexing produces any diagnostics are not cached, so that each
+/// preprocessor still reports its own errors for them.
+class SLANG_EXPORT TokenCache {
+public:
+    /// Gets the tokens for the given @a buffer, lexing and caching them first
+    /// if this is the first request for the buffer's text.
+    /// @returns the tokens, or an empty span if the buffer can't be cached.
+    std::span<const LexedToken> getTokens(const SourceBuffer& buffer,
+                                          KeywordVersion keywordVersion,
+                                          const LexerOptions& options);
+
+private:
+    struct Entry {
+        std::once_flag once;
+        BumpAllocator alloc;
+        std::vector<LexedToken> tokens;
+    };
+
+    std::mutex mutex;
+    flat_hash_map<std::tuple<const char*, KeywordVersion, LanguageVersion>,
+                  std::unique_ptr<Entry>>
+        entries;
+};
+
+} // namespace slang::parsing
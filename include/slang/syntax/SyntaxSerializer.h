@@ -0,0 +1,59 @@
+//------------------------------------------------------------------------------
+//! @file SyntaxSerializer.h
+//! @brief Binary serialization of syntax trees
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <memory>
+#include <span>
+
+#include "slang/util/SmallVector.h"
+#include "slang/util/Util.h"
+
+namespace slang {
+
+class Bag;
+class SourceManager;
+struct SourceBuffer;
+
+} // namespace slang
+
+namespace slang::syntax {
+
+class SyntaxTree;
+
+/// @brief Converts syntax trees to and from a compact binary form.
+///
+/// This is intended for caching the result of parsing a file so that later runs
+/// can skip lexing and parsing it again. Only self-contained trees can be serialized:
+/// the tree must have been parsed from a single buffer without any diagnostics, and
+/// every token in it must come directly from that buffer. In practice this rules out
+/// files that expand macros, include other files, or use `line or `pragma directives.
+///
+/// The serialized form refers back into the original source text instead of copying
+/// it, so it must be deserialized against a buffer with exactly the same contents.
+class SLANG_EXPORT SyntaxSerializer {
+public:
+    /// Serializes @a tree, which was parsed from @a buffer, appending the result
+    /// to @a output.
+    /// @returns true on success, or false if the tree can't be serialized,
+    /// in which case the contents of @a output are unspecified.
+    static bool serialize(const SyntaxTree& tree, const SourceBuffer& buffer,
+                          SmallVector<char>& output);
+
+    /// Reconstructs a syntax tree from @a data previously produced by @a serialize.
+    /// @a buffer must have the same contents as the buffer the tree was originally
+    /// parsed from. Note that the list of macros defined by the resulting tree is
+    /// always empty.
+    /// @returns the new tree, or nullptr if @a data is malformed or was produced by
+    /// an incompatible version of the serializer.
+    static std::shared_ptr<SyntaxTree> deserialize(std::span<const char> data,
+                                                   const SourceBuffer& buffer,
+                                                   SourceManager& sourceManager,
+                                                   const Bag& options);
+};
+
+} // namespace slang::syntax
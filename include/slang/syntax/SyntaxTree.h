@@ -223,6 +223,8 @@ public:
     static SourceManager& getDefaultSourceManager();
 
 private:
+    friend class SyntaxSerializer;
+
     SyntaxTree(SyntaxNode* root, const SourceLibrary* library, SourceManager& sourceManager,
                BumpAllocator&& alloc, Diagnostics&& diagnostics, parsing::ParserMetadata&& metadata,
                std::vector<const DefineDirectiveSyntax*>&& macros, Bag options);
@@ -26,10 +26,7 @@
 namespace slang {
 
 enum class DiagnosticSeverity;
-
-template<typename T>
-concept IsLock = std::is_same_v<T, std::shared_lock<std::shared_mutex>> ||
-                 std::is_same_v<T, std::unique_lock<std::shared_mutex>>;
+class MappedFile;
 
 /// SourceManager - Handles loading and tracking source files.
 ///
@@ -172,6 +169,13 @@ public:
     /// disabled to always use the simple filename.
     void setDisableProximatePaths(bool set) { disableProximatePaths = set; }
 
+    /// Sets whether source files read from disk should be memory mapped instead
+    /// of copied into memory. This can substantially reduce peak memory usage for
+    /// very large inputs, since file contents are paged in lazily and shared with
+    /// the OS page cache. Files that can't be mapped are read normally.
+    /// This is off by default.
+    void setMemoryMapFiles(bool set) { memoryMapFiles = set; }
+
     /// Adds a line directive at the given location.
     void addLineDirective(SourceLocation location, size_t lineNum, std::string_view name,
                           uint8_t level);
@@ -233,25 +237,30 @@ private:
     // Stores actual file contents and metadata; only one per loaded file
     struct FileData {
         const std::string name;                       // name of the file
-        const SmallVector<char> mem;                  // file contents
+        const SmallVector<char> mem;                  // file contents, if read into memory
+        const std::unique_ptr<MappedFile> mapping;    // file contents, if memory mapped
+        const std::string_view text;                  // view of contents (null terminated)
         std::vector<size_t> lineOffsets;              // cache of compute line offsets
+        std::once_flag lineOffsetsFlag;               // guards computing lineOffsets
         const std::filesystem::path* const directory; // directory in which the file exists
         const std::filesystem::path fullPath;         // full path to the file
 
         FileData(const std::filesystem::path* directory, std::string name, SmallVector<char>&& data,
-                 std::filesystem::path fullPath) :
-            name(std::move(name)), mem(std::move(data)), directory(directory),
-            fullPath(std::move(fullPath)) {}
+                 std::unique_ptr<MappedFile>&& mapping, std::filesystem::path fullPath);
+        ~FileData();
     };
 
     // Stores a pointer to file data along with information about where we included it.
-    // There can potentially be many of these for a given file.
+    // There can potentially be many of these for a given file. Everything except the
+    // line directives is immutable once created; lineDirectives is protected by the
+    // mutex, and hasLineDirectives lets readers skip taking it in the common case.
     struct FileInfo {
         FileData* data = nullptr;
         const SourceLibrary* library = nullptr;
         SourceLocation includedFrom;
         uint64_t sortKey;
         std::vector<LineDirectiveInfo> lineDirectives;
+        std::atomic<bool> hasLineDirectives = false;
 
         FileInfo() {}
         FileInfo(FileData* data, const SourceLibrary* library, SourceLocation includedFrom,
@@ -286,7 +295,46 @@ private:
             originalLoc(originalLoc), expansionRange(expansionRange), macroName(macroName) {}
     };
 
-    // This mutex protects pretty much everything in this class.
+    using BufferEntry = std::variant<FileInfo, ExpansionInfo>;
+
+    // Append-only storage for buffer entries. Entries live in chunks of doubling
+    // size that are never reallocated, so an entry's address is stable once
+    // created. New entries are published by a release store of the count, which
+    // lets readers look up any BufferID they've been handed without locking.
+    // Appending must be serialized externally.
+    class BufferEntryList {
+    public:
+        BufferEntryList() = default;
+        BufferEntryList(const BufferEntryList&) = delete;
+        BufferEntryList& operator=(const BufferEntryList&) = delete;
+        ~BufferEntryList();
+
+        size_t size() const { return count.load(std::memory_order_acquire); }
+
+        const BufferEntry& operator[](size_t index) const;
+        BufferEntry& operator[](size_t index) {
+            return const_cast<BufferEntry&>(std::as_const(*this)[index]);
+        }
+
+        template<typename T, typename... Args>
+        size_t emplace_back(Args&&... args);
+
+    private:
+        static constexpr size_t FirstChunkSize = 256;
+        static constexpr size_t MaxChunks = 24;
+
+        static size_t chunkIndex(size_t index);
+        static size_t chunkStart(size_t chunk) {
+            return FirstChunkSize * ((size_t(1) << chunk) - 1);
+        }
+
+        std::atomic<BufferEntry*> chunks[MaxChunks] = {};
+        std::atomic<size_t> count = 0;
+    };
+
+    // This mutex protects the lookup cache, directory lists, line and diagnostic
+    // directives, and serializes the creation of new buffer entries. Queries about
+    // existing buffers generally don't need it.
     mutable std::shared_mutex mutex;
 
     // This mutex is specifically for protecting the system and user
@@ -294,7 +342,7 @@ private:
     mutable std::shared_mutex includeDirMutex;
 
     // index from BufferID to buffer metadata
-    std::vector<std::variant<FileInfo, ExpansionInfo>> bufferEntries;
+    BufferEntryList bufferEntries;
 
     // cache for file lookups; this holds on to the actual file data
     flat_hash_map<std::string, std::pair<std::unique_ptr<FileData>, std::error_code>> lookupCache;
@@ -311,12 +359,10 @@ private:
 
     std::atomic<uint32_t> unnamedBufferCount = 0;
     bool disableProximatePaths = false;
+    bool memoryMapFiles = false;
 
-    template<IsLock TLock>
-    FileInfo* getFileInfo(BufferID buffer, TLock& lock);
-
-    template<IsLock TLock>
-    const FileInfo* getFileInfo(BufferID buffer, TLock& lock) const;
+    FileInfo* getFileInfo(BufferID buffer);
+    const FileInfo* getFileInfo(BufferID buffer) const;
 
     SourceBuffer createBufferEntry(FileData* fd, SourceLocation includedFrom,
                                    const SourceLibrary* library, uint64_t sortKey,
@@ -326,27 +372,17 @@ private:
                              const SourceLibrary* library, uint64_t sortKey = UINT64_MAX);
     SourceBuffer cacheBuffer(std::filesystem::path&& path, std::string&& pathStr,
                              SourceLocation includedFrom, const SourceLibrary* library,
-                             uint64_t sortKey, SmallVector<char>&& buffer);
-
-    template<IsLock TLock>
-    size_t getRawLineNumber(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    bool isMacroLocImpl(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    bool isMacroArgLocImpl(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    SourceLocation getFullyExpandedLocImpl(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    SourceLocation getOriginalLocImpl(SourceLocation location, TLock& lock) const;
+                             uint64_t sortKey, SmallVector<char>&& buffer,
+                             std::unique_ptr<MappedFile>&& mapping);
 
-    template<IsLock TLock>
-    SourceRange getExpansionRangeImpl(SourceLocation location, TLock& lock) const;
+    size_t getRawLineNumber(SourceLocation location) const;
+    bool isMacroLocImpl(SourceLocation location) const;
+    bool isMacroArgLocImpl(SourceLocation location) const;
+    SourceLocation getFullyExpandedLocImpl(SourceLocation location) const;
+    SourceLocation getOriginalLocImpl(SourceLocation location) const;
+    SourceRange getExpansionRangeImpl(SourceLocation location) const;
 
-    static void computeLineOffsets(const SmallVector<char>& buffer,
+    static void computeLineOffsets(std::string_view buffer,
                                    std::vector<size_t>& offsets) noexcept;
 };
 
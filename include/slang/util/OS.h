@@ -8,6 +8,7 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <fmt/color.h>
 
 #include "slang/util/ScopeGuard.h"
@@ -16,6 +17,26 @@
 
 namespace slang {
 
+/// A read-only view of a file's contents that has been mapped into memory.
+/// The mapping is released when the object is destroyed.
+/// @see OS::mapFile
+class SLANG_EXPORT MappedFile {
+public:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    /// Gets the contents of the file, including a trailing null terminator.
+    std::string_view data() const { return std::string_view(ptr, size + 1); }
+
+private:
+    friend class OS;
+    MappedFile(const char* ptr, size_t size) : ptr(ptr), size(size) {}
+
+    const char* ptr;
+    size_t size;
+};
+
 /// A collection of various OS-specific utility functions.
 class SLANG_EXPORT OS {
 public:
@@ -42,6 +63,27 @@ public:
     /// Note that the buffer will be null-terminated.
     static std::error_code readFile(const std::filesystem::path& path, SmallVector<char>& buffer);
 
+    /// Maps the file at @a path into memory as read-only. Like @a readFile, the
+    /// contents are guaranteed to be followed by a null terminator, which comes
+    /// from the zero-filled remainder of the last mapped page.
+    ///
+    /// Files that can't be mapped this way (stdin, pipes, empty files, or files
+    /// whose size is an exact multiple of the page size) are not an error;
+    /// @a result is left null and callers should fall back to @a readFile.
+    ///
+    /// Note that the file must not be truncated by another process while it
+    /// remains mapped.
+    static std::error_code mapFile(const std::filesystem::path& path,
+                                   std::unique_ptr<MappedFile>& result);
+
+    /// Gets the total CPU time, in seconds, consumed so far by all threads
+    /// of the current process, including time spent in the kernel.
+    static double getProcessCPUTime();
+
+    /// Gets the peak resident memory usage of the current process, in bytes,
+    /// or zero if it can't be determined.
+    static size_t getPeakMemoryUsage();
+
     /// Writes the given contents to the specified file.
     static void writeFile(const std::filesystem::path& path, std::string_view contents);
 
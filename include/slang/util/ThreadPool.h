@@ -1,6 +1,6 @@
 //------------------------------------------------------------------------------
 //! @file ThreadPool.h
-//! @brief Lightweight thread pool class
+//! @brief Lightweight work-stealing thread pool class
 //
 // SPDX-FileCopyrightText: Michael Popoloski
 // SPDX-License-Identifier: MIT
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <deque>
 #include <functional>
 #include <future>
@@ -21,7 +22,15 @@
 
 namespace slang {
 
-/// A lightweight thread pool for running concurrent jobs.
+/// @brief A lightweight thread pool for running concurrent jobs.
+///
+/// Each worker thread owns its own task queue. Tasks pushed from within a worker
+/// go onto that worker's queue and are run in LIFO order for locality; idle workers
+/// steal from the front of other workers' queues. Tasks pushed from outside the pool
+/// are distributed round-robin across the worker queues.
+///
+/// Tasks may push further tasks and may call @a waitForAll themselves; in that
+/// case the waiting worker helps run queued tasks instead of blocking.
 class ThreadPool {
 public:
     /// @brief Constructs a new ThreadPool.
@@ -36,14 +45,12 @@ public:
                 threadCount = 1;
         }
 
-        {
-            std::unique_lock lock(mutex);
-            waiting = false;
-            running = true;
-        }
+        queues = std::make_unique<WorkQueue[]>(threadCount);
+        numQueues = threadCount;
+        running = true;
 
         for (unsigned i = 0; i < threadCount; i++)
-            threads.emplace_back(&ThreadPool::worker, this);
+            threads.emplace_back(&ThreadPool::worker, this, size_t(i));
     }
 
     /// Destroys the thread pool, blocking until all threads have exited.
@@ -51,7 +58,7 @@ public:
         waitForAll();
 
         {
-            std::unique_lock lock(mutex);
+            std::unique_lock lock(sleepMutex);
             running = false;
         }
 
@@ -69,12 +76,7 @@ public:
     /// calling @a waitForAll and waiting for all tasks in the pool to complete.
     template<typename TFunc, typename... TArgs>
     void pushTask(TFunc&& task, TArgs&&... args) {
-        {
-            std::unique_lock lock(mutex);
-            tasks.emplace_back(std::bind(std::forward<TFunc>(task), std::forward<TArgs>(args)...));
-        }
-
-        taskAvailable.notify_one();
+        enqueue(std::bind(std::forward<TFunc>(task), std::forward<TArgs>(args)...));
     }
 
     /// @brief Submits a task into the pool for execution and returns a future
@@ -111,9 +113,12 @@ public:
     /// @brief Pushes several tasks into the pool in order to parallelize
     /// the loop given by [from, to).
     ///
-    /// The loop will be broken into a number of blocks as specified by
-    /// @a numBlocks -- or if zero, the number of blocks will be set to
-    /// the number of threads in the pool.
+    /// The loop is executed by a number of tasks as specified by @a numBlocks --
+    /// or if zero, the number of tasks will be set to the number of threads in the pool.
+    /// Rather than splitting the range into equal static blocks, each task repeatedly
+    /// claims chunks of the remaining range, starting with large chunks and shrinking
+    /// them as the range is consumed, so that a few expensive iterations don't leave
+    /// the other threads idle. @a body is invoked with each claimed [start, end) range.
     template<typename TIndex, typename TFunc>
     void pushLoop(TIndex from, TIndex to, TFunc&& body, size_t numBlocks = 0) {
         SLANG_ASSERT(to >= from);
@@ -124,25 +129,55 @@ public:
         if (!totalSize)
             return;
 
-        size_t blockSize = totalSize / numBlocks;
-        if (blockSize == 0) {
-            blockSize = 1;
+        if (numBlocks > totalSize)
             numBlocks = totalSize;
-        }
 
+        struct LoopState {
+            std::decay_t<TFunc> body;
+            std::atomic<size_t> next = 0;
+            size_t total;
+            size_t numBlocks;
+
+            LoopState(TFunc&& body, size_t total, size_t numBlocks) :
+                body(std::forward<TFunc>(body)), total(total), numBlocks(numBlocks) {}
+        };
+
+        auto state = std::make_shared<LoopState>(std::forward<TFunc>(body), totalSize, numBlocks);
         for (size_t i = 0; i < numBlocks; i++) {
-            const TIndex start = TIndex(i * blockSize) + from;
-            const TIndex end = i == numBlocks - 1 ? to : TIndex(start + blockSize);
-            pushTask(std::forward<TFunc>(body), start, end);
+            enqueue([state, from] {
+                while (true) {
+                    // Guided scheduling: claim a share of what's left, but at least one.
+                    size_t start = state->next.load(std::memory_order_relaxed);
+                    size_t chunk;
+                    do {
+                        if (start >= state->total)
+                            return;
+
+                        chunk = (state->total - start) / (state->numBlocks * 2);
+                        if (chunk == 0)
+                            chunk = 1;
+                    } while (!state->next.compare_exchange_weak(start, start + chunk,
+                                                                std::memory_order_relaxed));
+
+                    state->body(TIndex(from + TIndex(start)), TIndex(from + TIndex(start + chunk)));
+                }
+            });
         }
     }
 
-    /// Blocks the calling thread until all running tasks are complete.
+    /// @brief Blocks the calling thread until all running tasks are complete.
+    ///
+    /// If called from within a task running on this pool, the calling worker
+    /// will help execute queued tasks while it waits, and will return once all
+    /// tasks other than those that are themselves waiting have completed.
     void waitForAll() {
-        std::unique_lock lock(mutex);
-        waiting = true;
-        taskDone.wait(lock, [this] { return !currentTasks && tasks.empty(); });
-        waiting = false;
+        if (currentWorker().pool == this) {
+            helpUntilDone();
+            return;
+        }
+
+        std::unique_lock lock(waitMutex);
+        taskDone.wait(lock, [this] { return pendingTasks == 0; });
     }
 
     /// Blocks the calling thread until all running tasks are complete, or
@@ -150,43 +185,144 @@ public:
     /// @returns true if all tasks completed, or false if the timeout was reached first
     template<typename R, typename P>
     bool waitForAll(const std::chrono::duration<R, P>& duration) {
-        std::unique_lock lock(mutex);
-        waiting = true;
-        const bool status = taskDone.wait_for(lock, duration,
-                                              [this] { return !currentTasks && tasks.empty(); });
-        waiting = false;
-        return status;
+        std::unique_lock lock(waitMutex);
+        return taskDone.wait_for(lock, duration, [this] { return pendingTasks == 0; });
     }
 
 private:
-    void worker() {
+    using Task = std::function<void()>;
+
+    struct alignas(64) WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct WorkerInfo {
+        ThreadPool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    static WorkerInfo& currentWorker() {
+        static thread_local WorkerInfo info;
+        return info;
+    }
+
+    void enqueue(Task&& task) {
+        pendingTasks++;
+
+        // Tasks pushed from one of our own workers stay local to that worker;
+        // everything else gets spread around.
+        auto& info = currentWorker();
+        size_t index;
+        if (info.pool == this)
+            index = info.index;
+        else
+            index = nextQueue.fetch_add(1, std::memory_order_relaxed) % numQueues;
+
+        {
+            auto& queue = queues[index];
+            std::unique_lock lock(queue.mutex);
+            queue.tasks.emplace_back(std::move(task));
+        }
+
+        queuedTasks++;
+        if (sleepingWorkers > 0) {
+            std::unique_lock lock(sleepMutex);
+            taskAvailable.notify_one();
+        }
+    }
+
+    bool tryGetTask(size_t index, Task& task) {
+        if (queuedTasks == 0)
+            return false;
+
+        // Try our own queue first, taking the most recently pushed task.
+        {
+            auto& queue = queues[index];
+            std::unique_lock lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                queuedTasks--;
+                return true;
+            }
+        }
+
+        // Otherwise steal the oldest task from some other worker.
+        for (size_t i = 1; i < numQueues; i++) {
+            auto& queue = queues[(index + i) % numQueues];
+            std::unique_lock lock(queue.mutex, std::try_to_lock);
+            if (lock.owns_lock() && !queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                queuedTasks--;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void runTask(Task& task) {
+        task();
+        task = nullptr;
+
+        if (--pendingTasks == 0) {
+            std::unique_lock lock(waitMutex);
+            taskDone.notify_all();
+        }
+    }
+
+    void helpUntilDone() {
+        // The calling task is itself still pending, as are any others that
+        // are currently helping in this same way, so wait for those to be the
+        // only ones left.
+        nestedWaiters++;
+        Task task;
+        while (pendingTasks > nestedWaiters) {
+            if (tryGetTask(currentWorker().index, task))
+                runTask(task);
+            else
+                std::this_thread::yield();
+        }
+        nestedWaiters--;
+    }
+
+    void worker(size_t index) {
+        currentWorker() = {this, index};
+
+        Task task;
         while (true) {
-            std::unique_lock lock(mutex);
-            taskAvailable.wait(lock, [this] { return !tasks.empty() || !running; });
-            if (!running)
-                break;
+            if (tryGetTask(index, task)) {
+                runTask(task);
+                continue;
+            }
 
-            auto task = std::move(tasks.front());
-            tasks.pop_front();
-            ++currentTasks;
-            lock.unlock();
-            task();
-            lock.lock();
-            --currentTasks;
+            std::unique_lock lock(sleepMutex);
+            sleepingWorkers++;
+            taskAvailable.wait(lock, [this] { return queuedTasks > 0 || !running; });
+            sleepingWorkers--;
 
-            if (waiting && !currentTasks && tasks.empty())
-                taskDone.notify_all();
+            if (!running)
+                break;
         }
     }
 
-    std::mutex mutex;
-    std::deque<std::function<void()>> tasks;
+    std::unique_ptr<WorkQueue[]> queues;
+    size_t numQueues = 0;
+    std::vector<std::thread> threads;
+
+    std::atomic<size_t> pendingTasks = 0;
+    std::atomic<size_t> queuedTasks = 0;
+    std::atomic<size_t> nestedWaiters = 0;
+    std::atomic<size_t> sleepingWorkers = 0;
+    std::atomic<size_t> nextQueue = 0;
+
+    std::mutex sleepMutex;
     std::condition_variable taskAvailable;
+    std::mutex waitMutex;
     std::condition_variable taskDone;
-    std::vector<std::thread> threads;
-    size_t currentTasks = 0;
-    bool running;
-    bool waiting;
+    bool running = false;
 };
 
 } // namespace slang
@@ -57,6 +57,7 @@ def main():
         generatePyBindings(args.dir, alltypes)
     else:
         generateSyntaxClone(args.dir, alltypes, kindmap)
+        generateSyntaxDeserialize(args.dir, alltypes, kindmap)
         generateSyntax(args.dir, alltypes, kindmap)
         generateTokenKinds(ourdir, args.dir)
 
@@ -915,6 +916,103 @@ SyntaxNode* clone(const SyntaxNode& node, BumpAllocator& alloc) {
     )
 
 
+def generateSyntaxDeserialize(builddir, alltypes, kindmap):
+    outf = open(os.path.join(builddir, "SyntaxDeserialize.h"), "w")
+    outf.write(
+        """//------------------------------------------------------------------------------
+// SyntaxDeserialize.h
+// Generated syntax node deserialization
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "slang/syntax/AllSyntax.h"
+
+// This file contains the generated code for reconstructing syntax nodes from a
+// serialized stream. It is auto-generated by the syntax_gen.py script under
+// the scripts/ directory, and is only used internally by SyntaxSerializer.cpp.
+
+namespace slang::syntax::detail {
+
+// Reads the members of a syntax node of the given kind from the reader, in the same
+// order as they are reported by SyntaxNode::getChild, and constructs the node.
+template<typename TReader>
+SyntaxNode* deserializeNode(SyntaxKind kind, TReader& reader, BumpAllocator& alloc) {
+    switch (kind) {
+"""
+    )
+
+    kindsByType = {}
+    for k, v in sorted(kindmap.items()):
+        kindsByType.setdefault(v, []).append(k)
+
+    for name, kinds in sorted(kindsByType.items()):
+        v = alltypes[name]
+        if not v.final:
+            continue
+
+        for k in kinds:
+            outf.write("        case SyntaxKind::{}:\n".format(k))
+        outf.write("        {\n")
+
+        args = []
+        if "kind" in v.argNames:
+            args.append("kind")
+
+        for m in v.combinedMembers:
+            arg = m[1]
+            if m[0] == "Token":
+                outf.write("            auto {} = reader.readToken();\n".format(m[1]))
+            elif m[0] == "TokenList":
+                outf.write("            auto {} = reader.readTokenList();\n".format(m[1]))
+            elif m[0].startswith("SyntaxList<"):
+                outf.write(
+                    "            auto {} = reader.template readList<{}>();\n".format(
+                        m[1], m[2][11:-1]
+                    )
+                )
+            elif m[0].startswith("SeparatedSyntaxList<"):
+                outf.write(
+                    "            auto {} = reader.template readSeparatedList<{}>();\n".format(
+                        m[1], m[2][20:-1]
+                    )
+                )
+            elif m[1] in v.optionalMembers:
+                outf.write(
+                    "            auto {} = reader.template readOptionalNode<{}>();\n".format(
+                        m[1], m[2]
+                    )
+                )
+            else:
+                outf.write(
+                    "            auto {} = reader.template readNode<{}>();\n".format(
+                        m[1], m[2]
+                    )
+                )
+                outf.write(
+                    "            if (!{})\n                return nullptr;\n".format(m[1])
+                )
+                arg = "*" + m[1]
+            args.append(arg)
+
+        outf.write(
+            "            return alloc.emplace<{}>({});\n".format(name, ", ".join(args))
+        )
+        outf.write("        }\n")
+
+    outf.write(
+        """        default:
+            return nullptr;
+    }
+}
+
+} // namespace slang::syntax::detail
+"""
+    )
+
+
 def loadkinds(ourdir, filename):
     kinds = []
     inf = open(os.path.join(ourdir, filename))
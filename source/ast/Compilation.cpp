@@ -14,6 +14,7 @@
 
 #include "slang/ast/ScriptSession.h"
 #include "slang/ast/SystemSubroutine.h"
+#include "slang/ast/expressions/MiscExpressions.h"
 #include "slang/ast/types/TypePrinter.h"
 #include "slang/diagnostics/DiagnosticEngine.h"
 #include "slang/diagnostics/LookupDiags.h"
@@ -1094,6 +1095,33 @@ void Compilation::noteInstanceWithDefBind(const Symbol& instance) {
     instancesWithDefBinds[&def].push_back(&instance);
 }
 
+void Compilation::noteHierarchicalReference(const InstanceBodySymbol& body) {
+    bodiesWithHierarchicalRefs.emplace(&body);
+}
+
+bool Compilation::hasHierarchicalReferences(const InstanceBodySymbol& body) const {
+    return bodiesWithHierarchicalRefs.contains(&body);
+}
+
+void Compilation::noteSharedInstance(const InstanceSymbol& instance,
+                                     const InstanceBodySymbol* canonical) {
+    if (canonical)
+        canonicalBodies[&instance] = canonical;
+    else
+        canonicalBodies.erase(&instance);
+}
+
+const InstanceBodySymbol* Compilation::getCanonicalBody(const InstanceSymbol& instance) const {
+    if (auto it = canonicalBodies.find(&instance); it != canonicalBodies.end())
+        return it->second;
+    return nullptr;
+}
+
+void Compilation::noteInstantiation(const DefinitionSymbol& definition, const Scope& scope) {
+    if (hasFlag(CompilationFlags::EnableInstanceCaching))
+        cachedInstantiations.emplace_back(&definition, &scope);
+}
+
 void Compilation::noteDPIExportDirective(const DPIExportSyntax& syntax, const Scope& scope) {
     dpiExports.emplace_back(&syntax, &scope);
 }
@@ -1306,12 +1334,24 @@ CompilationUnitSymbol& Compilation::createScriptScope() {
 }
 
 void Compilation::elaborate() {
+    // Once the design has been elaborated, constants may be evaluated from
+    // multiple threads, so stop adding to the constant function call cache.
+    auto guard = ScopeGuard([this] {
+        std::unique_lock lock(constantCallMutex);
+        constantCallCacheFrozen.store(true, std::memory_order_release);
+    });
+
     // Touch every symbol, scope, statement, and expression tree so that
     // we can be sure we have all the diagnostics.
     uint32_t errorLimit = options.errorLimit == 0 ? UINT32_MAX : options.errorLimit;
     DiagnosticVisitor elabVisitor(*this, numErrors, errorLimit);
     getRoot().visit(elabVisitor);
 
+    if (!elabVisitor.sharedInstances.empty()) {
+        elabVisitor.revisitSharedInstances();
+        countSharedInstances(elabVisitor.sharedInstances);
+    }
+
     if (elabVisitor.finishedEarly())
         return;
 
@@ -1453,6 +1493,55 @@ void Compilation::elaborate() {
     }
 }
 
+void Compilation::countSharedInstances(std::span<const InstanceSymbol* const> sharedInstances) {
+    for (auto inst : sharedInstances)
+        sharedInstanceBodies[getCanonicalBody(*inst)].push_back(inst);
+
+    // Every instantiation elaborated in a body that stands for several
+    // instances was skipped in each of the shared copies of that body.
+    for (auto [definition, scope] : cachedInstantiations) {
+        if (auto multiplicity = getInstanceMultiplicity(scope->asSymbol()); multiplicity > 1)
+            elidedInstanceCounts[definition] += multiplicity - 1;
+    }
+}
+
+size_t Compilation::getInstanceMultiplicity(const Symbol& symbol) {
+    if (sharedInstanceBodies.empty())
+        return 1;
+
+    // Find the instance body containing the symbol, looking through checker bodies.
+    auto sym = &symbol;
+    while (sym->kind != SymbolKind::InstanceBody) {
+        const Scope* scope = nullptr;
+        if (sym->kind == SymbolKind::CheckerInstanceBody) {
+            if (auto parent = sym->as<CheckerInstanceBodySymbol>().parentInstance)
+                scope = parent->getParentScope();
+        }
+        else {
+            scope = sym->getParentScope();
+        }
+
+        if (!scope)
+            return 1;
+        sym = &scope->asSymbol();
+    }
+
+    auto& body = sym->as<InstanceBodySymbol>();
+    if (auto it = instanceMultiplicity.find(&body); it != instanceMultiplicity.end())
+        return it->second;
+
+    // A body stands for each copy of its own instance, plus each copy
+    // of the instances that share it via instance caching.
+    size_t result = body.parentInstance ? getInstanceMultiplicity(*body.parentInstance) : 1;
+    if (auto it = sharedInstanceBodies.find(&body); it != sharedInstanceBodies.end()) {
+        for (auto inst : it->second)
+            result += getInstanceMultiplicity(*inst);
+    }
+
+    instanceMultiplicity.emplace(&body, result);
+    return result;
+}
+
 const Diagnostics& Compilation::getParseDiagnostics() {
     if (cachedParseDiagnostics)
         return *cachedParseDiagnostics;
@@ -1523,7 +1612,10 @@ const Diagnostics& Compilation::getSemanticDiagnostics() {
             auto parent = symbol->as<InstanceBodySymbol>().parentInstance;
             SLANG_ASSERT(parent);
 
-            count++;
+            // If other instances share this body (or one of its parents) via
+            // instance caching, the diagnostic applies to all of them as well.
+            count += getInstanceMultiplicity(*symbol);
+
             if (auto scope = parent->getParentScope()) {
                 auto& sym = scope->asSymbol();
                 if (sym.kind != SymbolKind::Root && sym.kind != SymbolKind::CompilationUnit) {
@@ -1533,8 +1625,15 @@ const Diagnostics& Compilation::getSemanticDiagnostics() {
             }
         }
 
-        if (!differingArgs && found &&
-            inst->as<InstanceSymbol>().getDefinition().getInstanceCount() > count) {
+        size_t instanceCount = 0;
+        if (found) {
+            auto& def = inst->as<InstanceSymbol>().getDefinition();
+            instanceCount = def.getInstanceCount();
+            if (auto it = elidedInstanceCounts.find(&def); it != elidedInstanceCounts.end())
+                instanceCount += it->second;
+        }
+
+        if (!differingArgs && found && instanceCount > count) {
             // The diagnostic is present only in some instances, so include the coalescing
             // information to point the user towards the right ones.
             Diagnostic diag = *found;
@@ -1654,6 +1753,85 @@ void Compilation::forceElaborate(const Symbol& symbol) {
     symbol.visit(visitor);
 }
 
+static size_t hashConstantCall(const SubroutineSymbol& subroutine, bitmask<EvalFlags> flags,
+                               std::span<const ConstantValue> args) {
+    size_t h = 0;
+    hash_combine(h, &subroutine, flags.bits());
+    for (auto& arg : args)
+        hash_combine(h, arg.hash());
+    return h;
+}
+
+ConstantValue Compilation::findConstantCall(const SubroutineSymbol& subroutine,
+                                            bitmask<EvalFlags> flags,
+                                            std::span<const ConstantValue> args,
+                                            LookupLocation lookupLocation) {
+    // Entries can only be added until the cache is frozen, so after
+    // that it can be read without taking the lock.
+    std::shared_lock lock(constantCallMutex, std::defer_lock);
+    if (!constantCallCacheFrozen.load(std::memory_order_acquire))
+        lock.lock();
+
+    if (auto it = constantCallCache.find(hashConstantCall(subroutine, flags, args));
+        it != constantCallCache.end()) {
+        for (auto& entry : it->second) {
+            if (entry.subroutine != &subroutine || entry.flags != flags ||
+                !std::ranges::equal(entry.args, args)) {
+                continue;
+            }
+
+            // The function can only refer to parameters declared before the call,
+            // so the result isn't reusable if any of them come after this call site.
+            // Evaluating the call again will report the error.
+            if (!std::ranges::all_of(entry.dependencies, [&](const ValueSymbol* symbol) {
+                    return NamedValueExpression::isVisibleFromCallSite(*symbol, lookupLocation);
+                })) {
+                break;
+            }
+
+            constantCallHits.fetch_add(1, std::memory_order_relaxed);
+            return entry.result;
+        }
+    }
+
+    constantCallMisses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void Compilation::addConstantCall(const SubroutineSymbol& subroutine, bitmask<EvalFlags> flags,
+                                  std::span<const ConstantValue> args,
+                                  std::span<const ValueSymbol* const> dependencies,
+                                  const ConstantValue& result) {
+    // The number of entries is bounded so that designs making many distinct
+    // calls don't keep all of their arguments and results alive.
+    static constexpr size_t MaxEntries = 4096;
+    if (constantCallCacheFrozen.load(std::memory_order_acquire))
+        return;
+
+    std::unique_lock lock(constantCallMutex);
+    if (constantCallCacheFrozen.load(std::memory_order_relaxed) ||
+        numConstantCallEntries >= MaxEntries) {
+        return;
+    }
+
+    auto& entries = constantCallCache[hashConstantCall(subroutine, flags, args)];
+    for (auto& entry : entries) {
+        if (entry.subroutine == &subroutine && entry.flags == flags &&
+            std::ranges::equal(entry.args, args)) {
+            return;
+        }
+    }
+
+    numConstantCallEntries++;
+    entries.push_back({&subroutine, flags, {args.begin(), args.end()},
+                       {dependencies.begin(), dependencies.end()}, result});
+}
+
+Compilation::ConstantCallStats Compilation::getConstantCallStats() const {
+    return {constantCallHits.load(std::memory_order_relaxed),
+            constantCallMisses.load(std::memory_order_relaxed)};
+}
+
 const Type& Compilation::getType(SyntaxKind typeKind) const {
     auto it = knownTypes.find(typeKind);
     return it == knownTypes.end() ? *errorType : *it->second;
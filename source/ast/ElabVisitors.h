@@ -16,11 +16,35 @@ namespace slang::ast {
 
 using namespace syntax;
 
+// Hashes instance bodies by their definition and parameter values, for use
+// in looking up identical bodies when instance caching is enabled.
+struct InstanceCacheHash {
+    size_t operator()(const InstanceBodySymbol* body) const {
+        size_t h = 0;
+        hash_combine(h, &body->getDefinition());
+        for (auto param : body->getParameters()) {
+            auto& symbol = param->symbol;
+            if (symbol.kind == SymbolKind::Parameter)
+                hash_combine(h, symbol.as<ParameterSymbol>().getValue().hash());
+            else
+                hash_combine(h, symbol.as<TypeParameterSymbol>().targetType.getType().hash());
+        }
+        return h;
+    }
+};
+
+struct InstanceCacheEqual {
+    bool operator()(const InstanceBodySymbol* left, const InstanceBodySymbol* right) const {
+        return left->hasSameType(*right);
+    }
+};
+
 // This visitor is used to touch every node in the AST to ensure that all lazily
 // evaluated members have been realized and we have recorded every diagnostic.
 struct DiagnosticVisitor : public ASTVisitor<DiagnosticVisitor, false, false> {
     DiagnosticVisitor(Compilation& compilation, const size_t& numErrors, uint32_t errorLimit) :
-        compilation(compilation), numErrors(numErrors), errorLimit(errorLimit) {}
+        compilation(compilation), numErrors(numErrors), errorLimit(errorLimit),
+        instanceCachingEnabled(compilation.hasFlag(CompilationFlags::EnableInstanceCaching)) {}
 
     bool finishedEarly() const { return numErrors > errorLimit || hierarchyProblem; }
 
@@ -336,8 +360,12 @@ struct DiagnosticVisitor : public ASTVisitor<DiagnosticVisitor, false, false> {
             return;
         }
 
-        if (visitInstances)
+        if (visitInstances) {
+            if (instanceCachingEnabled && tryShareBody(symbol))
+                return;
+
             visit(symbol.body);
+        }
     }
 
     void handle(const SubroutineSymbol& symbol) {
@@ -420,6 +448,68 @@ struct DiagnosticVisitor : public ASTVisitor<DiagnosticVisitor, false, false> {
         symbol.getPathSource();
     }
 
+    // Checks whether the given instance's body can be shared with a previously
+    // elaborated identical body. If so, records that fact and returns true,
+    // in which case the body doesn't need to be visited.
+    bool tryShareBody(const InstanceSymbol& symbol) {
+        auto& body = symbol.body;
+        if (!isCacheable(symbol))
+            return false;
+
+        auto [it, inserted] = instanceCache.emplace(&body);
+        if (inserted)
+            return false;
+
+        auto canonical = *it;
+        if (compilation.hasHierarchicalReferences(*canonical))
+            return false;
+
+        compilation.noteSharedInstance(symbol, canonical);
+        sharedInstances.push_back(&symbol);
+        return true;
+    }
+
+    // Visits any instances previously skipped due to instance caching that
+    // have since become ineligible for sharing, because some hierarchical
+    // reference found later in the design reached into them.
+    void revisitSharedInstances() {
+        bool didSomething;
+        do {
+            didSomething = false;
+            auto instances = std::exchange(sharedInstances, {});
+            for (auto inst : instances) {
+                auto canonical = compilation.getCanonicalBody(*inst);
+                if (!compilation.hasHierarchicalReferences(inst->body) &&
+                    !compilation.hasHierarchicalReferences(*canonical)) {
+                    sharedInstances.push_back(inst);
+                    continue;
+                }
+
+                compilation.noteSharedInstance(*inst, nullptr);
+                visit(inst->body);
+                didSomething = true;
+            }
+        } while (didSomething && !finishedEarly());
+    }
+
+    bool isCacheable(const InstanceSymbol& symbol) const {
+        // Bodies with hierarchy overrides (defparams, binds), config rules, or
+        // uninstantiated flags all depend on their location in the hierarchy.
+        auto& body = symbol.body;
+        if (body.hierarchyOverrideNode || compilation.hasHierarchicalReferences(body) ||
+            body.flags.has(InstanceFlags::Uninstantiated) || symbol.resolvedConfig) {
+            return false;
+        }
+
+        // Interface ports resolve to whatever instance is connected to them,
+        // which can differ from instance to instance.
+        for (auto port : body.getPortList()) {
+            if (port->kind == SymbolKind::InterfacePort)
+                return false;
+        }
+        return true;
+    }
+
     void finalize() {
         // Once everything has been visited, go back over and check things that might
         // have been influenced by visiting later symbols. Unfortunately visiting
@@ -459,7 +549,10 @@ struct DiagnosticVisitor : public ASTVisitor<DiagnosticVisitor, false, false> {
     uint32_t errorLimit;
     bool visitInstances = true;
     bool hierarchyProblem = false;
+    bool instanceCachingEnabled = false;
     flat_hash_set<const InstanceBodySymbol*> activeInstanceBodies;
+    flat_hash_set<const InstanceBodySymbol*, InstanceCacheHash, InstanceCacheEqual> instanceCache;
+    SmallVector<const InstanceSymbol*> sharedInstances;
     flat_hash_set<const DefinitionSymbol*> usedIfacePorts;
     SmallVector<const GenericClassDefSymbol*> genericClasses;
     SmallVector<const SubroutineSymbol*> dpiImports;
@@ -591,6 +684,12 @@ struct PostElabVisitor : public ASTVisitor<PostElabVisitor, false, false> {
         // Ignore method prototype arguments, they're not unused.
     }
 
+    void handle(const InstanceSymbol& symbol) {
+        // Instances that share a canonical body would report the same things.
+        if (!compilation.getCanonicalBody(symbol))
+            visitDefault(symbol);
+    }
+
     void handle(const SubroutineSymbol& symbol) {
         if (symbol.flags.has(MethodFlags::Pure | MethodFlags::InterfaceExtern |
                              MethodFlags::DPIImport | MethodFlags::Randomize)) {
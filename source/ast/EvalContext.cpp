@@ -17,6 +17,22 @@
 
 namespace slang::ast {
 
+// Large fixed-size arrays of integral elements are stored packed while they
+// live in a local, which takes a fraction of the memory and copying time of
+// holding a separate ConstantValue for every element.
+static constexpr uint64_t MinDenseArrayElements = 256;
+
+static const Type* getDenseElementType(const Type& type) {
+    auto& ct = type.getCanonicalType();
+    if (ct.kind != SymbolKind::FixedSizeUnpackedArrayType ||
+        ct.getFixedRange().fullWidth() < MinDenseArrayElements) {
+        return nullptr;
+    }
+
+    auto elemType = ct.getArrayElementType();
+    return elemType->isIntegral() ? elemType : nullptr;
+}
+
 void EvalContext::reset() {
     steps = 0;
     disableTarget = nullptr;
@@ -31,18 +47,38 @@ void EvalContext::reset() {
 
 ConstantValue* EvalContext::createLocal(const ValueSymbol* symbol, ConstantValue value) {
     SLANG_ASSERT(!stack.empty());
-    ConstantValue& result = stack.back().temporaries[symbol];
+    auto& frame = stack.back();
+
+    // Creating a local that already exists (e.g. by executing its declaration
+    // again in a loop) reuses its slot.
+    ConstantValue* result;
+    if (auto slot = frame.findSlot(symbol); slot >= 0)
+        result = &frame.slots[size_t(slot)];
+    else
+        result = &frame.addSlot(symbol);
+
+    auto& type = symbol->getType();
+    auto denseElemType = getDenseElementType(type);
     if (!value) {
-        result = symbol->getType().getDefaultValue();
+        if (denseElemType) {
+            *result = SVDenseArray(type.getFixedRange().fullWidth(),
+                                   denseElemType->getDefaultValue().integer(),
+                                   denseElemType->isFourState());
+        }
+        else {
+            *result = type.getDefaultValue();
+        }
     }
     else {
-        SLANG_ASSERT(!value.isInteger() ||
-                     value.integer().getBitWidth() == symbol->getType().getBitWidth());
+        SLANG_ASSERT(!value.isInteger() || value.integer().getBitWidth() == type.getBitWidth());
 
-        result = std::move(value);
+        if (denseElemType && value.isUnpacked() && SVDenseArray::canPack(value.elements()))
+            *result = SVDenseArray::pack(value.elements(), denseElemType->isFourState());
+        else
+            *result = std::move(value);
     }
 
-    return &result;
+    return result;
 }
 
 ConstantValue* EvalContext::findLocal(const ValueSymbol* symbol) {
@@ -50,16 +86,17 @@ ConstantValue* EvalContext::findLocal(const ValueSymbol* symbol) {
         return nullptr;
 
     auto& frame = stack.back();
-    auto it = frame.temporaries.find(symbol);
-    if (it == frame.temporaries.end())
+    auto slot = frame.findSlot(symbol);
+    if (slot < 0)
         return nullptr;
-    return &it->second;
+    return &frame.slots[size_t(slot)];
 }
 
 void EvalContext::deleteLocal(const ValueSymbol* symbol) {
     if (!stack.empty()) {
         auto& frame = stack.back();
-        frame.temporaries.erase(symbol);
+        if (auto slot = frame.findSlot(symbol); slot >= 0)
+            frame.clearSlot(size_t(slot));
     }
 }
 
@@ -87,6 +124,13 @@ void EvalContext::popFrame() {
     stack.pop_back();
 }
 
+void EvalContext::addCallSiteDependency(const ValueSymbol& symbol) {
+    SLANG_ASSERT(!stack.empty());
+    auto& deps = stack.back().callSiteDependencies;
+    if (std::ranges::find(deps, &symbol) == deps.end())
+        deps.push_back(&symbol);
+}
+
 void EvalContext::pushLValue(LValue& lval) {
     lvalStack.push_back(&lval);
 }
@@ -115,8 +159,10 @@ std::string EvalContext::dumpStack() const {
     int index = 0;
     for (const Frame& frame : stack) {
         buffer.format("{}: {}\n", index++, frame.subroutine ? frame.subroutine->name : "<global>");
-        for (auto& [symbol, value] : frame.temporaries)
-            buffer.format("    {} = {}\n", symbol->name, value.toString());
+        for (size_t i = 0; i < frame.symbols.size(); i++) {
+            if (auto symbol = frame.symbols[i])
+                buffer.format("    {} = {}\n", symbol->name, frame.slots[i].toString());
+        }
     }
     return buffer.str();
 }
@@ -171,10 +217,10 @@ static void reportFrame(Diagnostic& diag, const EvalContext::Frame& frame) {
     buffer.format("{}(", frame.subroutine->name);
 
     for (auto arg : frame.subroutine->getArguments()) {
-        auto it = frame.temporaries.find(arg);
-        SLANG_ASSERT(it != frame.temporaries.end());
+        auto slot = frame.findSlot(arg);
+        SLANG_ASSERT(slot >= 0);
 
-        buffer.append(it->second.toString());
+        buffer.append(frame.slots[size_t(slot)].toString());
         if (arg != frame.subroutine->getArguments().last(1)[0])
             buffer.append(", ");
     }
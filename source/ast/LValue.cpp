@@ -18,8 +18,15 @@ ConstantValue* LValue::resolve() {
     if (!std::holds_alternative<Path>(value))
         return nullptr;
 
+    // Callers can modify the resolved target in arbitrary ways,
+    // so densely packed storage needs to be unpacked first.
+    auto& path = std::get<Path>(value);
+    if (path.base->isDenseArray())
+        *path.base = path.base->denseArray()->unpack();
+
     std::optional<ConstantRange> range;
-    ConstantValue* target = resolveInternal(range);
+    std::optional<size_t> denseIndex;
+    ConstantValue* target = resolveInternal(range, denseIndex);
 
     // If there is no singular target, return nullptr to indicate.
     if (range.has_value())
@@ -52,8 +59,36 @@ ConstantValue LValue::load() const {
 
     // Otherwise, we have an lvalue path. Walk the path and apply each element.
     auto& path = std::get<Path>(value);
-    ConstantValue result = *path.base;
-    for (auto& elem : path.elements) {
+    std::span<const PathElement> pathElems = path.elements;
+
+    ConstantValue result;
+    if (path.base->isDenseArray()) {
+        // Read selected elements straight out of packed storage instead of
+        // copying the whole array first. The packed form itself never escapes.
+        auto& dense = *path.base->denseArray();
+        auto index = pathElems.empty() ? nullptr : std::get_if<ElementIndex>(&pathElems[0]);
+        if (index) {
+            if (index->forceOutOfBounds || index->index < 0 ||
+                size_t(index->index) >= dense.size()) {
+                result = index->defaultValue;
+            }
+            else {
+                result = dense.get(size_t(index->index));
+            }
+            pathElems = pathElems.subspan(1);
+        }
+        else if (pathElems.empty()) {
+            return dense.unpack();
+        }
+        else {
+            result = *path.base;
+        }
+    }
+    else {
+        result = *path.base;
+    }
+
+    for (auto& elem : pathElems) {
         if (!result)
             return nullptr;
 
@@ -145,10 +180,25 @@ void LValue::store(const ConstantValue& newValue) {
     }
 
     std::optional<ConstantRange> range;
-    ConstantValue* target = resolveInternal(range);
+    std::optional<size_t> denseIndex;
+    ConstantValue* target = resolveInternal(range, denseIndex);
     if (!target || target->bad())
         return;
 
+    // Elements of a dense array are written back into their packed storage.
+    if (denseIndex) {
+        auto& dense = *target->denseArray();
+        if (!range) {
+            dense.set(*denseIndex, newValue.integer());
+        }
+        else {
+            SVInt elem = dense.get(*denseIndex);
+            elem.set(range->upper(), range->lower(), newValue.integer());
+            dense.set(*denseIndex, elem);
+        }
+        return;
+    }
+
     // We have the final target, now assign to it.
     // If there is no range specified, we should be able to assign straight to the target.
     if (!range) {
@@ -165,6 +215,12 @@ void LValue::store(const ConstantValue& newValue) {
             }
         }
 
+        // Keep dense arrays packed when the whole array is assigned.
+        if (target->isDenseArray() && newValue.isUnpacked() &&
+            target->denseArray()->assign(newValue.elements())) {
+            return;
+        }
+
         *target = newValue;
         return;
     }
@@ -192,6 +248,17 @@ void LValue::store(const ConstantValue& newValue) {
         for (int32_t i = std::max(l, 0); i <= u; i++)
             dest[size_t(i)] = src[size_t(i - l)];
     }
+    else if (target->isDenseArray()) {
+        int32_t l = range->lower();
+        int32_t u = range->upper();
+
+        auto src = newValue.elements();
+        auto& dest = *target->denseArray();
+
+        u = std::min(u, int32_t(dest.size()) - 1);
+        for (int32_t i = std::max(l, 0); i <= u; i++)
+            dest.set(size_t(i), src[size_t(i - l)].integer());
+    }
     else {
         int32_t l = range->lower();
         int32_t u = range->upper();
@@ -205,7 +272,8 @@ void LValue::store(const ConstantValue& newValue) {
     }
 }
 
-ConstantValue* LValue::resolveInternal(std::optional<ConstantRange>& range) {
+ConstantValue* LValue::resolveInternal(std::optional<ConstantRange>& range,
+                                       std::optional<size_t>& denseIndex) {
     auto& path = std::get<Path>(value);
     ConstantValue* target = path.base;
 
@@ -214,7 +282,7 @@ ConstantValue* LValue::resolveInternal(std::optional<ConstantRange>& range) {
             break;
 
         std::visit(
-            [&target, &range](auto&& arg) {
+            [&target, &range, &denseIndex](auto&& arg) {
                 using T = std::decay_t<decltype(arg)>;
                 if constexpr (std::is_same_v<T, BitSlice>) {
                     if (!range)
@@ -259,6 +327,14 @@ ConstantValue* LValue::resolveInternal(std::optional<ConstantRange>& range) {
                         else
                             range = ConstantRange{arg.index, arg.index};
                     }
+                    else if (target->isDenseArray()) {
+                        // Packed elements can't be pointed to, so remember the index
+                        // and leave the target as the array itself.
+                        if (arg.index < 0 || size_t(arg.index) >= target->denseArray()->size())
+                            target = nullptr;
+                        else
+                            denseIndex = size_t(arg.index);
+                    }
                     else {
                         auto elems = target->elements();
                         if (arg.index < 0 || size_t(arg.index) >= elems.size())
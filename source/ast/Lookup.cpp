@@ -972,6 +972,55 @@ const Symbol* findSuperHandle(const Scope& scope, bitmask<LookupFlags> flags, So
     return base;
 }
 
+const InstanceBodySymbol* getContainingBody(const Symbol& symbol) {
+    if (symbol.kind == SymbolKind::InstanceBody)
+        return &symbol.as<InstanceBodySymbol>();
+
+    auto scope = symbol.getParentScope();
+    while (scope) {
+        auto& sym = scope->asSymbol();
+        if (sym.kind == SymbolKind::InstanceBody)
+            return &sym.as<InstanceBodySymbol>();
+        scope = sym.getParentScope();
+    }
+    return nullptr;
+}
+
+const InstanceBodySymbol* getParentBody(const InstanceBodySymbol& body) {
+    return body.parentInstance ? getContainingBody(*body.parentInstance) : nullptr;
+}
+
+bool isWithinBody(const Symbol& symbol, const InstanceBodySymbol& body) {
+    for (auto curr = getContainingBody(symbol); curr; curr = getParentBody(*curr)) {
+        if (curr == &body)
+            return true;
+    }
+    return false;
+}
+
+// Marks instance bodies whose elaboration depends on a hierarchical reference
+// that crosses their boundary, so that instance caching won't share them.
+// That includes bodies containing the reference that don't also contain the
+// start of the path (i.e. the reference goes upward) as well as bodies containing
+// the target that don't also contain the reference (i.e. they are being looked into).
+void noteHierarchicalReference(const Scope& scope, const LookupResult& result) {
+    auto& comp = scope.getCompilation();
+    if (!comp.hasFlag(CompilationFlags::EnableInstanceCaching))
+        return;
+
+    auto& site = scope.asSymbol();
+    auto& pathRoot = result.path.empty() ? *result.found : *result.path[0].symbol;
+    for (auto body = getContainingBody(site); body && !isWithinBody(pathRoot, *body);
+         body = getParentBody(*body)) {
+        comp.noteHierarchicalReference(*body);
+    }
+
+    for (auto body = getContainingBody(*result.found); body && !isWithinBody(site, *body);
+         body = getParentBody(*body)) {
+        comp.noteHierarchicalReference(*body);
+    }
+}
+
 bool withinCovergroup(const Symbol& symbol, const Scope& initialScope) {
     const Scope* nextScope = &initialScope;
     do {
@@ -1012,6 +1061,9 @@ void Lookup::name(const NameSyntax& syntax, const ASTContext& context, bitmask<L
             unwrapResult(scope, syntax.sourceRange(), result);
             if (flags.has(LookupFlags::NoSelectors))
                 result.errorIfSelectors(context);
+
+            if (result.found && result.flags.has(LookupResultFlags::IsHierarchical))
+                noteHierarchicalReference(scope, result);
             return;
         case SyntaxKind::ThisHandle:
             result.found = findThisHandle(scope, flags, syntax.sourceRange(), result);
@@ -1081,6 +1133,9 @@ void Lookup::name(const NameSyntax& syntax, const ASTContext& context, bitmask<L
         if (flags.has(LookupFlags::AlwaysAllowUpward)) {
             if (!lookupUpward({}, name, context, flags, result))
                 return;
+
+            if (result.found)
+                noteHierarchicalReference(scope, result);
         }
 
         if (!result.found && !result.hasError())
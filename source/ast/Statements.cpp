@@ -901,11 +901,9 @@ ER VariableDeclStatement::evalImpl(EvalContext& context) const {
         }
     }
 
-    if (!initial)
-        initial = symbol.getType().getDefaultValue();
-
-    // Create storage for the variable.
-    context.createLocal(&symbol, initial);
+    // Create storage for the variable. Without an initial value this
+    // will use the default value for the variable's type.
+    context.createLocal(&symbol, std::move(initial));
     return ER::Success;
 }
 
@@ -2014,10 +2012,22 @@ ER ForeachLoopStatement::evalImpl(EvalContext& context) const {
     if (loopDims.empty())
         return ER::Success;
 
-    ConstantValue cv = arrayRef.eval(context);
-    if (!cv)
+    // Looping over a densely packed local only needs its fixed ranges,
+    // so avoid unpacking a copy of the whole array.
+    const ConstantValue* local = nullptr;
+    if (arrayRef.kind == ExpressionKind::NamedValue)
+        local = arrayRef.as<NamedValueExpression>().evalLocal(context);
+
+    ConstantValue cv;
+    if (local && local->bad())
         return ER::Fail;
 
+    if (!local || !local->isDenseArray()) {
+        cv = arrayRef.eval(context);
+        if (!cv)
+            return ER::Fail;
+    }
+
     ER result = evalRecursive(context, cv, loopDims);
     if (result == ER::Break || result == ER::Continue)
         return ER::Success;
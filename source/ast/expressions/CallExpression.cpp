@@ -709,6 +709,50 @@ Expression& CallExpression::createSystemCall(
     return *expr;
 }
 
+// Checks whether the given value is no bigger than @a budget, measured in
+// elements of containers and words of integers, and deducts its size from it.
+static bool fitsBudget(const ConstantValue& value, size_t& budget) {
+    size_t size = 1;
+    if (value.isInteger())
+        size = value.integer().getNumWords();
+    else if (value.isContainer() || value.isDenseArray() || value.isString())
+        size = std::max(value.size(), size_t(1));
+
+    if (size > budget)
+        return false;
+    budget -= size;
+
+    if (value.isUnpacked()) {
+        for (auto& elem : value.elements()) {
+            if (!fitsBudget(elem, budget))
+                return false;
+        }
+    }
+    else if (value.isQueue()) {
+        for (auto& elem : *value.queue()) {
+            if (!fitsBudget(elem, budget))
+                return false;
+        }
+    }
+    else if (value.isMap()) {
+        for (auto& [key, elem] : *value.map()) {
+            if (!fitsBudget(key, budget) || !fitsBudget(elem, budget))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Checks whether the given call arguments are small enough to be worth caching.
+static bool isSmallEnoughToCache(std::span<const ConstantValue> args) {
+    size_t budget = 256;
+    for (auto& arg : args) {
+        if (!fitsBudget(arg, budget))
+            return false;
+    }
+    return true;
+}
+
 ConstantValue CallExpression::evalImpl(EvalContext& context) const {
     // If thisClass() is set call eval on it to be sure an error is issued.
     if (thisClass()) {
@@ -736,6 +780,26 @@ ConstantValue CallExpression::evalImpl(EvalContext& context) const {
         args.emplace_back(std::move(v));
     }
 
+    // Constant functions can't have side effects, so a successful call that didn't
+    // issue any diagnostics can be reused by later calls with the same arguments.
+    // Scripts and covergroups relax the rules on what the function can reference,
+    // and some AST flags change which diagnostics get issued, so skip those.
+    // Calls made from within another function are covered by the outermost call,
+    // and calls with large arguments cost more to hash and compare than to evaluate.
+    auto& comp = context.getCompilation();
+    const auto cacheFlags = context.flags & ~EvalFlags::CacheResults;
+    const bool useCache = !context.inFunction() &&
+                          !context.flags.has(EvalFlags::IsScript | EvalFlags::CovergroupExpr) &&
+                          !context.astCtx.flags.has(ASTFlags::ConfigParam |
+                                                    ASTFlags::UnevaluatedBranch) &&
+                          isSmallEnoughToCache(args);
+    if (useCache) {
+        if (auto cached = comp.findConstantCall(symbol, cacheFlags, args, lookupLocation))
+            return cached;
+    }
+
+    const size_t diagCount = context.getDiagnosticCount();
+
     // Push a new stack frame, push argument values as locals.
     if (!context.pushFrame(symbol, sourceRange.start(), lookupLocation))
         return nullptr;
@@ -757,6 +821,13 @@ ConstantValue CallExpression::evalImpl(EvalContext& context) const {
         context.addDiag(diag::ConstEvalDisableTarget, context.getDisableRange());
 
     ConstantValue result = std::move(*context.findLocal(symbol.returnValVar));
+    if (result.isDenseArray())
+        result = result.denseArray()->unpack();
+    if (useCache && (er == ER::Success || er == ER::Return) && result &&
+        context.getDiagnosticCount() == diagCount) {
+        comp.addConstantCall(symbol, cacheFlags, args, context.topFrame().callSiteDependencies,
+                             result);
+    }
     context.popFrame();
 
     if (er == ER::Fail || er == ER::Disable)
@@ -390,8 +390,12 @@ ConstantValue NamedValueExpression::evalImpl(EvalContext& context) const {
             return symbol.as<SpecparamSymbol>().getValue(sourceRange);
         default:
             ConstantValue* v = context.findLocal(&symbol);
-            if (v)
+            if (v) {
+                // Densely packed locals are only ever exposed in unpacked form.
+                if (v->isDenseArray())
+                    return v->denseArray()->unpack();
                 return *v;
+            }
             break;
     }
 
@@ -434,6 +438,17 @@ LValue NamedValueExpression::evalLValueImpl(EvalContext& context) const {
     return LValue(*cv);
 }
 
+const ConstantValue* NamedValueExpression::evalLocal(EvalContext& context) const {
+    auto local = context.findLocal(&symbol);
+    if (!local)
+        return nullptr;
+
+    if (!checkConstant(context))
+        return &ConstantValue::Invalid;
+
+    return local;
+}
+
 bool NamedValueExpression::checkConstant(EvalContext& context) const {
     if (context.flags.has(EvalFlags::IsScript))
         return true;
@@ -467,27 +482,35 @@ bool NamedValueExpression::checkConstant(EvalContext& context) const {
         }
     }
     else {
-        // Check whether the referenced parameter is declared prior to the invocation
-        // of the constant function. If the two locations are not in the same compilation
-        // unit, assume that it's ok. Also if the reference is via a package import
-        // that's fine too.
-        auto compare = symbol.isDeclaredBefore(frame.lookupLocation);
-        if (!compare.value_or(true)) {
-            auto scope = symbol.getParentScope();
-            if (!scope || scope->asSymbol().kind != SymbolKind::Package ||
-                scope == frame.lookupLocation.getScope()) {
-
-                auto& diag = context.addDiag(diag::ConstEvalIdUsedInCEBeforeDecl, sourceRange)
-                             << symbol.name;
-                diag.addNote(diag::NoteDeclarationHere, symbol.location);
-                return false;
-            }
+        if (!isVisibleFromCallSite(symbol, frame.lookupLocation)) {
+            auto& diag = context.addDiag(diag::ConstEvalIdUsedInCEBeforeDecl, sourceRange)
+                         << symbol.name;
+            diag.addNote(diag::NoteDeclarationHere, symbol.location);
+            return false;
         }
+        context.addCallSiteDependency(symbol);
     }
 
     return true;
 }
 
+bool NamedValueExpression::isVisibleFromCallSite(const ValueSymbol& symbol,
+                                                 LookupLocation lookupLocation) {
+    // Check whether the referenced parameter is declared prior to the invocation
+    // of the constant function. If the two locations are not in the same compilation
+    // unit, assume that it's ok. Also if the reference is via a package import
+    // that's fine too.
+    auto compare = symbol.isDeclaredBefore(lookupLocation);
+    if (!compare.value_or(true)) {
+        auto scope = symbol.getParentScope();
+        if (!scope || scope->asSymbol().kind != SymbolKind::Package ||
+            scope == lookupLocation.getScope()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 ConstantValue HierarchicalValueExpression::evalImpl(EvalContext& context) const {
     if (!context.getCompilation().hasFlag(CompilationFlags::AllowHierarchicalConst) &&
         !context.astCtx.flags.has(ASTFlags::ConfigParam)) {
@@ -223,6 +223,28 @@ bool ElementSelectExpression::isConstantSelect(EvalContext& context) const {
 }
 
 ConstantValue ElementSelectExpression::evalImpl(EvalContext& context) const {
+    // Selecting from a fixed size unpacked array held in a local variable is common
+    // in constant functions that build lookup tables, so read the element directly
+    // from the variable instead of copying the whole array first.
+    const Type& valType = *value().type;
+    if (valType.isUnpackedArray() && valType.hasFixedRange() &&
+        value().kind == ExpressionKind::NamedValue && !value().bad()) {
+        if (auto local = value().as<NamedValueExpression>().evalLocal(context)) {
+            if (!*local)
+                return nullptr;
+
+            bool softFail = false;
+            ConstantValue associativeIndex;
+            auto range = evalIndex(context, *local, associativeIndex, softFail);
+            if (!range)
+                return softFail ? type->getDefaultValue() : nullptr;
+
+            if (local->isDenseArray())
+                return local->denseArray()->get(size_t(range->left));
+            return local->elements()[size_t(range->left)];
+        }
+    }
+
     ConstantValue cv = value().eval(context);
     if (!cv)
         return nullptr;
@@ -238,7 +260,6 @@ ConstantValue ElementSelectExpression::evalImpl(EvalContext& context) const {
     }
 
     // Handling for packed and unpacked arrays, all integer types.
-    const Type& valType = *value().type;
     if (valType.hasFixedRange()) {
         // For fixed types, we know we will always be in range, so just do the selection.
         if (valType.isUnpackedArray())
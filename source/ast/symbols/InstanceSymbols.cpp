@@ -646,6 +646,7 @@ void InstanceSymbol::fromSyntax(Compilation& comp, const HierarchyInstantiationS
 
         auto& definition = def->as<DefinitionSymbol>();
         definition.noteInstantiated();
+        comp.noteInstantiation(definition, *context.scope);
 
         if (inChecker) {
             addDiag(diag::InvalidInstanceForParent)
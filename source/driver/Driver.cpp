@@ -8,8 +8,10 @@
 //------------------------------------------------------------------------------
 #include "slang/driver/Driver.h"
 
+#include <chrono>
 #include <fmt/color.h>
 
+#include "slang/ast/ASTVisitor.h"
 #include "slang/ast/Compilation.h"
 #include "slang/ast/symbols/CompilationUnitSymbols.h"
 #include "slang/ast/symbols/InstanceSymbols.h"
@@ -108,6 +110,13 @@ void Driver::addStandardArgs() {
                 "<count>");
     cmdLine.add("-j,--threads", options.numThreads,
                 "The number of threads to use to parallelize parsing", "<count>");
+    cmdLine.add("--mmap-sources", options.mmapSources,
+                "Memory map source files instead of reading them into memory, "
+                "which reduces peak memory usage for very large inputs");
+    cmdLine.add("--syntax-cache", options.syntaxCacheDir,
+                "A directory in which to cache parsed syntax trees, which speeds up "
+                "later runs over source files that haven't changed",
+                "<dir>");
 
     cmdLine.add(
         "-C",
@@ -185,6 +194,9 @@ void Driver::addStandardArgs() {
     addCompFlag(CompilationFlags::StrictDriverChecking, "--strict-driver-checking",
                 "Perform strict driver checking, which currently means disabling "
                 "procedural 'for' loop unrolling.");
+    addCompFlag(CompilationFlags::EnableInstanceCaching, "--enable-instance-caching",
+                "Share elaboration work between instances with identical definitions "
+                "and parameter values.");
     addCompFlag(CompilationFlags::LintMode, "--lint-only",
                 "Only perform linting of code, don't try to elaborate a full hierarchy");
 
@@ -224,6 +236,9 @@ void Driver::addStandardArgs() {
                 "Limit on the number of errors that will be printed. Setting this to zero will "
                 "disable the limit.",
                 "<limit>");
+    cmdLine.add("--stats", options.showStats,
+                "Print a summary of the time and memory used by each phase of "
+                "compilation, along with counts of tokens, syntax nodes, and symbols");
 
     cmdLine.add(
         "--suppress-warnings",
@@ -486,6 +501,9 @@ bool Driver::processOptions() {
             opt = true;
     }
 
+    if (options.mmapSources == true)
+        sourceManager.setMemoryMapFiles(true);
+
     if (!reportLoadErrors())
         return false;
 
@@ -691,6 +709,8 @@ void Driver::addParseOptions(Bag& bag) const {
     soptions.singleUnit = options.singleUnit == true;
     soptions.onlyLint = options.lintMode();
     soptions.librariesInheritMacros = options.librariesInheritMacros == true;
+    if (options.syntaxCacheDir)
+        soptions.syntaxCacheDir = *options.syntaxCacheDir;
 
     PreprocessorOptions ppoptions;
     ppoptions.predefines = options.defines;
@@ -925,6 +945,77 @@ void Driver::printWarning(const std::string& message) {
     OS::printE("\n");
 }
 
+void Driver::measurePhase(std::string_view name, function_ref<void()> func) {
+    auto wallStart = std::chrono::steady_clock::now();
+    auto cpuStart = OS::getProcessCPUTime();
+
+    func();
+
+    std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - wallStart;
+    phaseStats.push_back({std::string(name), wallTime.count(), OS::getProcessCPUTime() - cpuStart,
+                          OS::getPeakMemoryUsage()});
+}
+
+static void countSyntax(const SyntaxNode& node, size_t& numTokens, size_t& numSyntaxNodes) {
+    numSyntaxNodes++;
+    for (size_t i = 0; i < node.getChildCount(); i++) {
+        if (auto child = node.childNode(i))
+            countSyntax(*child, numTokens, numSyntaxNodes);
+        else if (node.childToken(i))
+            numTokens++;
+    }
+}
+
+struct SymbolCounter : public ASTVisitor<SymbolCounter, false, false> {
+    size_t numSymbols = 0;
+    size_t numInstances = 0;
+
+    template<typename T>
+        requires std::is_base_of_v<Symbol, T>
+    void handle(const T& symbol) {
+        numSymbols++;
+        if constexpr (std::is_same_v<T, InstanceSymbol>)
+            numInstances++;
+        visitDefault(symbol);
+    }
+};
+
+void Driver::reportStats(Compilation* compilation) {
+    std::string result = fmt::format("\n{:<12}{:>12}{:>12}{:>16}\n", "Phase", "Wall (s)",
+                                     "CPU (s)", "Peak mem (MB)");
+
+    double totalWall = 0, totalCPU = 0;
+    for (auto& phase : phaseStats) {
+        result += fmt::format("{:<12}{:>12.3f}{:>12.3f}{:>16.1f}\n", phase.name, phase.wallTime,
+                              phase.cpuTime, double(phase.peakMemory) / (1024 * 1024));
+        totalWall += phase.wallTime;
+        totalCPU += phase.cpuTime;
+    }
+
+    result += fmt::format("{:<12}{:>12.3f}{:>12.3f}{:>16.1f}\n\n", "total", totalWall, totalCPU,
+                          double(OS::getPeakMemoryUsage()) / (1024 * 1024));
+
+    size_t numTokens = 0, numSyntaxNodes = 0;
+    for (auto& tree : syntaxTrees)
+        countSyntax(tree->root(), numTokens, numSyntaxNodes);
+
+    result += fmt::format("{:<16}{}\n", "Tokens:", numTokens);
+    result += fmt::format("{:<16}{}\n", "Syntax nodes:", numSyntaxNodes);
+
+    if (compilation) {
+        SymbolCounter counter;
+        compilation->getRoot().visit(counter);
+
+        auto constantCalls = compilation->getConstantCallStats();
+        result += fmt::format("{:<16}{}\n", "Symbols:", counter.numSymbols);
+        result += fmt::format("{:<16}{}\n", "Instances:", counter.numInstances);
+        result += fmt::format("{:<16}{} hits, {} misses\n", "Const fn cache:",
+                              constantCalls.hits, constantCalls.misses);
+    }
+
+    OS::print(result);
+}
+
 bool Driver::Options::lintMode() const {
     return compilationFlags.at(CompilationFlags::LintMode) == true;
 }
@@ -8,13 +8,21 @@
 #include "slang/driver/SourceLoader.h"
 
 #include <fmt/core.h>
+#include <fstream>
+#include <random>
 
+#include "slang/parsing/Parser.h"
 #include "slang/parsing/Preprocessor.h"
+#include "slang/parsing/TokenCache.h"
 #include "slang/syntax/AllSyntax.h"
+#include "slang/syntax/SyntaxSerializer.h"
 #include "slang/syntax/SyntaxTree.h"
 #include "slang/text/SourceManager.h"
+#include "slang/util/OS.h"
 #include "slang/util/String.h"
 #include "slang/util/ThreadPool.h"
+#include "slang/util/TimeTrace.h"
+#include "slang/util/VersionInfo.h"
 
 namespace fs = std::filesystem;
 
@@ -225,9 +233,16 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
         }
     };
 
+    // Separate units tend to include the same headers, so share a token cache
+    // between them so that those headers only get lexed once.
+    std::shared_ptr<parsing::TokenCache> unitTokenCache;
+
     auto parseSeparateUnit = [&](const UnitEntry& unit, const std::vector<SourceBuffer>& buffers) {
         auto unitOptions = optionBag;
         auto& ppOptions = unitOptions.insertOrGet<parsing::PreprocessorOptions>();
+        if (!ppOptions.tokenCache)
+            ppOptions.tokenCache = unitTokenCache;
+
         ppOptions.predefines.insert(ppOptions.predefines.end(), unit.defines.begin(),
                                     unit.defines.end());
         ppOptions.additionalIncludePaths.insert(ppOptions.additionalIncludePaths.end(),
@@ -246,12 +261,34 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
         std::vector<LoadResult> loadResults;
         loadResults.resize(fileEntries.size());
 
+        // Schedule the largest files first so that a few huge files don't
+        // end up being started last and holding up the rest of the work.
+        // Results are still stored by their original index to keep the
+        // output order deterministic.
+        std::vector<std::pair<uintmax_t, size_t>> schedule;
+        schedule.reserve(fileEntries.size());
+        for (size_t i = 0; i < fileEntries.size(); i++) {
+            std::error_code ec;
+            auto size = fs::file_size(fileEntries[i].path, ec);
+            schedule.emplace_back(ec ? 0 : size, i);
+        }
+
+        std::ranges::stable_sort(schedule, std::ranges::greater{},
+                                 [](auto& item) { return item.first; });
+
         // Load all source files that were specified on the command line
-        // or via library maps.
-        threadPool.pushLoop(size_t(0), fileEntries.size(), [&](size_t start, size_t end) {
-            for (size_t i = start; i < end; i++)
-                loadResults[i] = loadAndParse(fileEntries[i], optionBag, srcOptions, i);
-        });
+        // or via library maps. Asking for one block per file makes each
+        // worker claim a single file at a time, in schedule order, instead
+        // of taking a whole chunk of the largest files at once.
+        threadPool.pushLoop(
+            size_t(0), schedule.size(),
+            [&](size_t start, size_t end) {
+                for (size_t index = start; index < end; index++) {
+                    auto i = schedule[index].second;
+                    loadResults[i] = loadAndParse(fileEntries[i], optionBag, srcOptions, i);
+                }
+            },
+            schedule.size());
         threadPool.waitForAll();
 
         for (auto&& result : loadResults)
@@ -261,6 +298,9 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
 
         // Parse separate unit groups into their own syntax trees.
         if (!unitToBufferMap.empty()) {
+            if (unitToBufferMap.size() > 1)
+                unitTokenCache = std::make_shared<parsing::TokenCache>();
+
             std::vector<std::pair<const UnitEntry* const, std::vector<SourceBuffer>>*> unitList;
             unitList.reserve(unitToBufferMap.size());
             for (auto& pair : unitToBufferMap)
@@ -306,6 +346,9 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
 
         // Parse separate unit groups into their own syntax trees.
         if (!unitToBufferMap.empty()) {
+            if (unitToBufferMap.size() > 1)
+                unitTokenCache = std::make_shared<parsing::TokenCache>();
+
             for (auto& [unit, buffers] : unitToBufferMap)
                 syntaxTrees.emplace_back(parseSeparateUnit(*unit, buffers));
         }
@@ -377,48 +420,102 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
         for (auto& tree : syntaxTrees)
             findMissingNames(tree, missingNames);
 
-        // Keep loading new files as long as we are making forward progress.
-        flat_hash_set<std::string_view> nextMissingNames;
-        while (true) {
-            for (auto name : missingNames) {
-                SourceBuffer buffer;
-                for (auto& dir : searchDirectories) {
-                    fs::path path(dir);
-                    path /= name;
-
-                    for (auto& ext : searchExtensions) {
-                        path.replace_extension(ext);
-                        if (!sourceManager.isCached(path)) {
-                            // This file is never part of a library because if
-                            // it was we would have already loaded it earlier.
-                            auto readResult = sourceManager.readSource(path, /* library */ nullptr);
-                            if (readResult) {
-                                buffer = *readResult;
-                                break;
-                            }
-                        }
+        // List the contents of each search directory once up front, so that looking
+        // for a missing name doesn't have to probe the filesystem for every directory
+        // and extension. Names are lowercased so that we never miss a file on a case
+        // insensitive filesystem; a match still has to be confirmed by reading the file.
+        // Directories that can't be listed are left without an index and probed as usual.
+        std::vector<std::optional<flat_hash_set<std::string>>> dirIndex(searchDirectories.size());
+        for (size_t i = 0; i < searchDirectories.size() && !missingNames.empty(); i++) {
+            std::error_code ec;
+            fs::directory_iterator it(searchDirectories[i], ec);
+            if (ec)
+                continue;
+
+            auto& names = dirIndex[i].emplace();
+            for (; !ec && it != fs::directory_iterator(); it.increment(ec)) {
+                auto name = getU8Str(it->path().filename());
+                strToLower(name);
+                names.emplace(std::move(name));
+            }
+
+            if (ec)
+                dirIndex[i].reset();
+        }
+
+        auto findLibraryFile = [&](std::string_view name) -> SourceBuffer {
+            for (size_t i = 0; i < searchDirectories.size(); i++) {
+                fs::path path(searchDirectories[i]);
+                path /= name;
+
+                for (auto& ext : searchExtensions) {
+                    path.replace_extension(ext);
+                    if (auto& names = dirIndex[i]) {
+                        auto fileName = getU8Str(path.filename());
+                        strToLower(fileName);
+                        if (!names->contains(fileName))
+                            continue;
                     }
 
-                    if (buffer)
-                        break;
+                    if (!sourceManager.isCached(path)) {
+                        // This file is never part of a library because if
+                        // it was we would have already loaded it earlier.
+                        auto readResult = sourceManager.readSource(path, /* library */ nullptr);
+                        if (readResult)
+                            return *readResult;
+                    }
                 }
+            }
+            return {};
+        };
+
+        std::optional<ThreadPool> threadPool;
+        auto parseLibraryFiles = [&](std::span<const SourceBuffer> buffers) {
+            const size_t numTrees = syntaxTrees.size();
+            syntaxTrees.resize(numTrees + buffers.size());
 
-                if (buffer) {
-                    auto tree = SyntaxTree::fromBuffer(buffer, sourceManager, optionBag,
+            auto parse = [&](size_t start, size_t end) {
+                for (size_t i = start; i < end; i++) {
+                    auto tree = SyntaxTree::fromBuffer(buffers[i], sourceManager, optionBag,
                                                        inheritedMacros);
                     tree->isLibraryUnit = true;
-                    syntaxTrees.emplace_back(tree);
-
-                    addKnownNames(tree);
-                    findMissingNames(tree, nextMissingNames);
+                    syntaxTrees[i + numTrees] = std::move(tree);
                 }
+            };
+
+            if (buffers.size() >= MinFilesForThreading && srcOptions.numThreads != 1u) {
+                if (!threadPool)
+                    threadPool.emplace(srcOptions.numThreads.value_or(0u));
+
+                threadPool->pushLoop(size_t(0), buffers.size(), parse);
+                threadPool->waitForAll();
+            }
+            else {
+                parse(0, buffers.size());
             }
+        };
 
-            if (nextMissingNames.empty())
-                break;
+        // Keep loading new files as long as we are making forward progress.
+        // Each wave finds the files for all of the currently missing names,
+        // parses them together, and then collects the names they are missing.
+        std::vector<SourceBuffer> buffers;
+        while (!missingNames.empty()) {
+            buffers.clear();
+            for (auto name : missingNames) {
+                if (auto buffer = findLibraryFile(name))
+                    buffers.push_back(buffer);
+            }
+
+            const size_t firstNewTree = syntaxTrees.size();
+            parseLibraryFiles(buffers);
+
+            std::span newTrees(syntaxTrees.begin() + ptrdiff_t(firstNewTree), syntaxTrees.end());
+            for (auto& tree : newTrees)
+                addKnownNames(tree);
 
-            missingNames = std::move(nextMissingNames);
-            nextMissingNames = {};
+            missingNames.clear();
+            for (auto& tree : newTrees)
+                findMissingNames(tree, missingNames);
         }
     }
 
@@ -527,6 +624,8 @@ SourceLoader::LoadResult SourceLoader::loadAndParse(const FileEntry& entry, cons
                                                     uint64_t fileSortKey) {
     // TODO: error if secondLib is set
 
+    TimeTraceScope timeScope("loadAndParse"sv, [&] { return getU8Str(entry.path); });
+
     auto buffer = sourceManager.readSource(entry.path, entry.library, fileSortKey);
     if (!buffer)
         return std::pair{&entry, buffer.error()};
@@ -548,7 +647,9 @@ SourceLoader::LoadResult SourceLoader::loadAndParse(const FileEntry& entry, cons
     }
     else {
         // Otherwise we can parse right away.
-        auto tree = SyntaxTree::fromBuffer(*buffer, sourceManager, optionBag);
+        auto tree = srcOptions.syntaxCacheDir.empty()
+                        ? SyntaxTree::fromBuffer(*buffer, sourceManager, optionBag)
+                        : parseCached(*buffer, optionBag, srcOptions.syntaxCacheDir);
         if (entry.isLibraryFile || srcOptions.onlyLint)
             tree->isLibraryUnit = true;
 
@@ -556,6 +657,84 @@ SourceLoader::LoadResult SourceLoader::loadAndParse(const FileEntry& entry, cons
     }
 }
 
+static std::string getSyntaxCacheName(const SourceBuffer& buffer, const Bag& optionBag) {
+    // The name combines a hash of the file's contents with a hash of everything
+    // else that can affect the resulting tree, so we never need to check for
+    // stale entries -- a changed file or option just results in a different name.
+    auto ppOptions = optionBag.getOrDefault<parsing::PreprocessorOptions>();
+    auto lexerOptions = optionBag.getOrDefault<parsing::LexerOptions>();
+    auto parserOptions = optionBag.getOrDefault<parsing::ParserOptions>();
+
+    std::string key(VersionInfo::getHash());
+    key += fmt::format(";{};{};{};{};{}", toString(ppOptions.languageVersion),
+                       toString(lexerOptions.languageVersion),
+                       toString(parserOptions.languageVersion), lexerOptions.maxErrors,
+                       parserOptions.maxRecursionDepth);
+
+    for (auto& define : ppOptions.predefines)
+        key += fmt::format(";D{}", define);
+    for (auto& undef : ppOptions.undefines)
+        key += fmt::format(";U{}", undef);
+
+    std::vector<std::string_view> ignored(ppOptions.ignoreDirectives.begin(),
+                                          ppOptions.ignoreDirectives.end());
+    std::ranges::sort(ignored);
+    for (auto name : ignored)
+        key += fmt::format(";I{}", name);
+
+    // The buffer includes a trailing null terminator, which we don't need to hash.
+    auto text = buffer.data.substr(0, buffer.data.size() - 1);
+    return fmt::format("{:016x}-{:016x}.slangst",
+                       slang::detail::hashing::hash(text.data(), text.size()),
+                       slang::detail::hashing::hash(key.data(), key.size()));
+}
+
+std::shared_ptr<SyntaxTree> SourceLoader::parseCached(const SourceBuffer& buffer,
+                                                      const Bag& optionBag,
+                                                      const fs::path& cacheDir) {
+    // Failures to read or write the cache are not errors; we just
+    // fall back to parsing the file as though there were no cache.
+    auto cachePath = cacheDir / getSyntaxCacheName(buffer, optionBag);
+
+    SmallVector<char> data;
+    if (!OS::readFile(cachePath, data)) {
+        // Ignore the null terminator added by readFile.
+        auto tree = SyntaxSerializer::deserialize(std::span(data.data(), data.size() - 1), buffer,
+                                                  sourceManager, optionBag);
+        if (tree)
+            return tree;
+    }
+
+    auto tree = SyntaxTree::fromBuffer(buffer, sourceManager, optionBag);
+
+    data.clear();
+    if (!SyntaxSerializer::serialize(*tree, buffer, data))
+        return tree;
+
+    // Write to a uniquely named temporary file and then move it into place,
+    // so that concurrent runs never observe a partially written entry.
+    std::error_code ec;
+    fs::create_directories(cacheDir, ec);
+
+    auto tempPath = cachePath;
+    tempPath += fmt::format(".{:x}.tmp", std::random_device()());
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), (std::streamsize)data.size());
+        if (!file.good()) {
+            file.close();
+            fs::remove(tempPath, ec);
+            return tree;
+        }
+    }
+
+    fs::rename(tempPath, cachePath, ec);
+    if (ec)
+        fs::remove(tempPath, ec);
+
+    return tree;
+}
+
 void SourceLoader::addError(const std::filesystem::path& path, std::error_code ec) {
     errors.emplace_back(fmt::format("'{}': {}", getU8Str(path), ec.message()));
 }
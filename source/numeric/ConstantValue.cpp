@@ -95,6 +95,10 @@ std::string ConstantValue::toString(bitwidth_t abbreviateThresholdBits, bool exa
                                    arg->value.toString(abbreviateThresholdBits, exactUnknowns,
                                                        useAssignmentPatterns));
             }
+            else if constexpr (std::is_same_v<T, DenseArray>) {
+                return ConstantValue(arg->unpack())
+                    .toString(abbreviateThresholdBits, exactUnknowns, useAssignmentPatterns);
+            }
             else {
                 static_assert(always_false<T>::value, "Missing case");
             }
@@ -143,6 +147,10 @@ size_t ConstantValue::hash() const {
                     hash_combine(h, arg->value.hash());
                 }
             }
+            else if constexpr (std::is_same_v<T, DenseArray>) {
+                // Hash the same as the equivalent element list, since the two compare equal.
+                h = ConstantValue(arg->unpack()).hash();
+            }
             else {
                 static_assert(always_false<T>::value, "Missing case");
             }
@@ -165,6 +173,8 @@ size_t ConstantValue::size() const {
                 return arg->size();
             else if constexpr (std::is_same_v<T, Queue>)
                 return arg->size();
+            else if constexpr (std::is_same_v<T, DenseArray>)
+                return arg->size();
             else if constexpr (std::is_same_v<T, std::string>)
                 return arg.size();
             else
@@ -221,6 +231,21 @@ ConstantValue ConstantValue::getSlice(int32_t upper, int32_t lower,
         return result;
     }
 
+    if (isDenseArray()) {
+        auto& dense = *denseArray();
+        std::vector<ConstantValue> result;
+        result.reserve(size_t(upper - lower + 1));
+
+        for (int32_t i = lower; i <= upper; i++) {
+            if (i < 0 || size_t(i) >= dense.size())
+                result.emplace_back(defaultValue);
+            else
+                result.emplace_back(dense.get(size_t(i)));
+        }
+
+        return result;
+    }
+
     if (isQueue()) {
         auto& q = *queue();
         SVQueue result;
@@ -307,6 +332,9 @@ bool ConstantValue::hasUnknown() const {
                 }
                 return false;
             }
+            else if constexpr (std::is_same_v<T, DenseArray>) {
+                return arg->hasUnknown();
+            }
             else {
                 return false;
             }
@@ -505,6 +533,10 @@ uint64_t ConstantValue::getBitstreamWidth() const {
     else if (isUnion()) {
         width = unionVal()->value.getBitstreamWidth();
     }
+    else if (isDenseArray()) {
+        auto& dense = *denseArray();
+        width = uint64_t(dense.size()) * dense.elementWidth();
+    }
 
     return width;
 }
@@ -530,6 +562,9 @@ bool operator==(const ConstantValue& lhs, const ConstantValue& rhs) {
             else if constexpr (std::is_same_v<T, ConstantValue::UnboundedPlaceholder>)
                 return rhs.isUnbounded();
             else if constexpr (std::is_same_v<T, ConstantValue::Elements>) {
+                if (rhs.isDenseArray())
+                    return arg == rhs.denseArray()->unpack();
+
                 if (!rhs.isUnpacked())
                     return false;
 
@@ -556,6 +591,9 @@ bool operator==(const ConstantValue& lhs, const ConstantValue& rhs) {
                 auto& ru = rhs.unionVal();
                 return arg->activeMember == ru->activeMember && arg->value == ru->value;
             }
+            else if constexpr (std::is_same_v<T, ConstantValue::DenseArray>) {
+                return ConstantValue(arg->unpack()) == rhs;
+            }
             else {
                 static_assert(always_false<T>::value, "Missing case");
             }
@@ -591,6 +629,9 @@ std::partial_ordering operator<=>(const ConstantValue& lhs, const ConstantValue&
             else if constexpr (std::is_same_v<T, ConstantValue::UnboundedPlaceholder>)
                 return unordered;
             else if constexpr (std::is_same_v<T, ConstantValue::Elements>) {
+                if (rhs.isDenseArray())
+                    return arg <=> rhs.denseArray()->unpack();
+
                 if (!rhs.isUnpacked())
                     return unordered;
 
@@ -620,6 +661,9 @@ std::partial_ordering operator<=>(const ConstantValue& lhs, const ConstantValue&
 
                 return *arg <=> *rhs.unionVal();
             }
+            else if constexpr (std::is_same_v<T, ConstantValue::DenseArray>) {
+                return ConstantValue(arg->unpack()) <=> rhs;
+            }
             else {
                 static_assert(always_false<T>::value, "Missing case");
             }
@@ -627,6 +671,140 @@ std::partial_ordering operator<=>(const ConstantValue& lhs, const ConstantValue&
         lhs.value);
 }
 
+static uint64_t elementMask(bitwidth_t width) {
+    return width == 64 ? ~0ull : (1ull << width) - 1;
+}
+
+SVDenseArray::SVDenseArray(size_t count, const SVInt& initial, bool isFourState) :
+    count(count), width(initial.getBitWidth()), signFlag(initial.isSigned()),
+    fourState(isFourState) {
+
+    // Elements up to a word wide are packed side by side without straddling
+    // word boundaries; wider elements each get their own run of words.
+    if (width <= 64) {
+        size_t perWord = 64 / width;
+        planeWords = (count + perWord - 1) / perWord;
+    }
+    else {
+        planeWords = count * ((width + 63) / 64);
+    }
+    words.resize(fourState ? planeWords * 2 : planeWords);
+
+    if (initial.hasUnknown() || initial.getActiveBits() != 0) {
+        for (size_t i = 0; i < count; i++)
+            set(i, initial);
+    }
+}
+
+bool SVDenseArray::canPack(std::span<const ConstantValue> elements) {
+    if (elements.empty() || !elements[0].isInteger())
+        return false;
+
+    bitwidth_t width = elements[0].integer().getBitWidth();
+    return std::ranges::all_of(elements, [width](const ConstantValue& elem) {
+        return elem.isInteger() && elem.integer().getBitWidth() == width;
+    });
+}
+
+SVDenseArray SVDenseArray::pack(std::span<const ConstantValue> elements, bool isFourState) {
+    SLANG_ASSERT(canPack(elements));
+    auto& first = elements[0].integer();
+
+    SVDenseArray result(elements.size(), SVInt(first.getBitWidth(), 0, first.isSigned()),
+                        isFourState);
+    for (size_t i = 0; i < elements.size(); i++)
+        result.set(i, elements[i].integer());
+
+    return result;
+}
+
+bool SVDenseArray::hasUnknown() const {
+    if (!fourState)
+        return false;
+
+    return std::any_of(unknownPlane(), unknownPlane() + planeWords,
+                       [](uint64_t word) { return word != 0; });
+}
+
+SVInt SVDenseArray::get(size_t index) const {
+    SLANG_ASSERT(index < count);
+    if (width <= 64) {
+        size_t perWord = 64 / width;
+        size_t word = index / perWord;
+        uint32_t shift = uint32_t(index % perWord) * width;
+        uint64_t mask = elementMask(width);
+
+        uint64_t value = (words[word] >> shift) & mask;
+        if (fourState) {
+            uint64_t unknown = (unknownPlane()[word] >> shift) & mask;
+            if (unknown)
+                return SVInt::fromRawWords(width, signFlag, {&value, 1}, {&unknown, 1});
+        }
+        return SVInt(width, value, signFlag);
+    }
+
+    size_t numWords = (width + 63) / 64;
+    size_t offset = index * numWords;
+    std::span<const uint64_t> value(words.data() + offset, numWords);
+    if (fourState)
+        return SVInt::fromRawWords(width, signFlag, value, {unknownPlane() + offset, numWords});
+
+    return SVInt::fromRawWords(width, signFlag, value);
+}
+
+void SVDenseArray::set(size_t index, const SVInt& value) {
+    SLANG_ASSERT(index < count);
+    SLANG_ASSERT(value.getBitWidth() == width);
+
+    // SVInt keeps its unknown mask words directly after its value words.
+    const uint64_t* data = value.getRawPtr();
+    const bool anyUnknown = value.hasUnknown();
+    if (width <= 64) {
+        size_t perWord = 64 / width;
+        size_t word = index / perWord;
+        uint32_t shift = uint32_t(index % perWord) * width;
+        uint64_t mask = elementMask(width);
+
+        // Two-state storage has no room for unknowns; they become zeros.
+        uint64_t unknown = anyUnknown ? data[1] : 0;
+        uint64_t bits = fourState ? data[0] : data[0] & ~unknown;
+        words[word] = (words[word] & ~(mask << shift)) | ((bits & mask) << shift);
+        if (fourState) {
+            uint64_t& dest = unknownPlane()[word];
+            dest = (dest & ~(mask << shift)) | ((unknown & mask) << shift);
+        }
+        return;
+    }
+
+    size_t numWords = (width + 63) / 64;
+    size_t offset = index * numWords;
+    for (size_t i = 0; i < numWords; i++) {
+        uint64_t unknown = anyUnknown ? data[numWords + i] : 0;
+        words[offset + i] = fourState ? data[i] : data[i] & ~unknown;
+        if (fourState)
+            unknownPlane()[offset + i] = unknown;
+    }
+}
+
+bool SVDenseArray::assign(std::span<const ConstantValue> elements) {
+    if (elements.size() != count || !canPack(elements) ||
+        elements[0].integer().getBitWidth() != width) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++)
+        set(i, elements[i].integer());
+    return true;
+}
+
+ConstantValue::Elements SVDenseArray::unpack() const {
+    ConstantValue::Elements result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; i++)
+        result.emplace_back(get(i));
+    return result;
+}
+
 ConstantRange ConstantRange::subrange(ConstantRange select) const {
     int32_t l = lower();
     ConstantRange result;
@@ -254,8 +254,147 @@ SVInt SVInt::fromDigits(bitwidth_t bits, LiteralBase base, bool isSigned, bool a
     return fromPow2Digits(bits, isSigned, anyUnknown, radix, shift, digits);
 }
 
+// Decimal conversions of large values split the value in half by a power of ten of the form
+// 10^(18 * 2^i), convert each half on its own, and then combine the results. Values with no
+// more than these numbers of digits or bits are converted directly a word at a time instead.
+static constexpr size_t DecimalChunkDigits = 18 * 2048;
+static constexpr bitwidth_t DecimalChunkBits = 2048;
+
+// Gets the number of bits needed to hold any decimal number with the given number of digits.
+static bitwidth_t bitsForDecimalDigits(size_t numDigits) {
+    return bitwidth_t(std::ceil(double(numDigits) * log2_10)) + 1;
+}
+
+// Gets a copy of the given value with its width changed to the given number of bits,
+// either by zero extending it or by truncating it from the left.
+static SVInt resizeUnsigned(const SVInt& value, bitwidth_t bits) {
+    if (value.getBitWidth() < bits)
+        return value.extend(bits, false);
+    if (value.getBitWidth() > bits)
+        return value.trunc(bits);
+    return value;
+}
+
+// Computes floor(2^(2n) / value) for an n bit wide value that has its top bit set.
+// Large values start from the reciprocal of their top half and take one Newton step
+// to refine it, so the cost is a few multiplications instead of a long division.
+static SVInt reciprocal(const SVInt& value) {
+    bitwidth_t n = value.getBitWidth();
+    if (n <= DecimalChunkBits)
+        return SVInt(2 * n + 2, 1, false).shl(2 * n) / value;
+
+    // Round the top bits up so that the starting estimate is never too large.
+    bitwidth_t h = n / 2 + 4;
+    SVInt top = value.lshr(n - h).trunc(h + 1) + SVInt(h + 1, 1, false);
+    top = top.trunc(top.getActiveBits());
+
+    bitwidth_t topBits = top.getBitWidth();
+    bitwidth_t width = 3 * n + 4;
+    SVInt one(width, 1, false);
+    SVInt pow2 = one.shl(2 * n);
+    SVInt divisor = value.extend(width, false);
+    SVInt result = reciprocal(top).extend(width, false).shl(n + h - 2 * topBits);
+
+    // Newton's iteration for a reciprocal approaches it from below, doubling the number
+    // of correct bits each step, which leaves the result at most a few units too small.
+    SVInt error = pow2 - divisor * result;
+    result += (result * error).lshr(2 * n);
+    error = pow2 - divisor * result;
+    while (error >= divisor) {
+        result += one;
+        error -= divisor;
+    }
+    return result.trunc(2 * n + 2);
+}
+
+struct SVInt::DecimalPowers {
+    // The number of decimal digits in the smallest power, 10^18, which fits in one word.
+    static constexpr size_t BaseDigits = 18;
+
+    // Gets the number of decimal digits in the remainder of a division
+    // by the power at the given level.
+    static size_t numDigits(uint32_t level) { return BaseDigits << level; }
+
+    // Gets 10^(18 * 2^level), which is exactly as wide as its active bits.
+    const SVInt& get(uint32_t level) {
+        if (powers.empty())
+            powers.push_back({SVInt(60, 1'000'000'000'000'000'000ull, false), std::nullopt});
+
+        while (powers.size() <= level) {
+            auto& last = powers.back().value;
+            SVInt next = last.extend(last.getBitWidth() * 2, false);
+            next *= next;
+            powers.push_back({next.trunc(next.getActiveBits()), std::nullopt});
+        }
+        return powers[level].value;
+    }
+
+    // Divides a value by the power at the given level, returning the quotient and leaving
+    // the remainder in @a value. The value must fit in twice the width of the power.
+    SVInt divide(uint32_t level, SVInt& value) {
+        auto& divisor = get(level);
+        auto& power = powers[level];
+        if (!power.reciprocal)
+            power.reciprocal = reciprocal(divisor);
+
+        // Barrett reduction: the estimated quotient is at most two less than the real one.
+        bitwidth_t n = divisor.getBitWidth();
+        SVInt x = resizeUnsigned(value, 2 * n + 2);
+        SVInt quotient = (x.lshr(n - 1) * *power.reciprocal).lshr(n + 1);
+        SVInt remainder = x - quotient * divisor;
+        while (remainder >= divisor) {
+            remainder -= divisor;
+            quotient += SVInt(quotient.getBitWidth(), 1, false);
+        }
+
+        value = std::move(remainder);
+        return quotient;
+    }
+
+private:
+    struct Power {
+        SVInt value;
+        std::optional<SVInt> reciprocal;
+    };
+    SmallVector<Power> powers;
+};
+
 SVInt SVInt::fromDecimalDigits(bitwidth_t bits, bool isSigned, std::span<logic_t const> digits) {
-    SVInt result = allocZeroed(bits, isSigned, false);
+    SVInt result;
+    if (digits.size() <= DecimalChunkDigits) {
+        result = fromDecimalChunk(digits);
+    }
+    else {
+        DecimalPowers powers;
+        result = fromDecimalDigits(powers, digits);
+    }
+
+    result = resizeUnsigned(result, bits);
+    result.setSigned(isSigned);
+    return result;
+}
+
+SVInt SVInt::fromDecimalDigits(DecimalPowers& powers, std::span<logic_t const> digits) {
+    if (digits.size() <= DecimalChunkDigits)
+        return fromDecimalChunk(digits);
+
+    // Split off the largest power that leaves at least half of the digits on the left.
+    uint32_t level = 0;
+    while (DecimalPowers::numDigits(level + 1) < digits.size())
+        level++;
+
+    size_t split = digits.size() - DecimalPowers::numDigits(level);
+    SVInt result = fromDecimalDigits(powers, digits.first(split));
+    result = result.extend(bitsForDecimalDigits(digits.size()), false);
+    result *= powers.get(level);
+    result += fromDecimalDigits(powers, digits.subspan(split));
+    return result;
+}
+
+SVInt SVInt::fromDecimalChunk(std::span<logic_t const> digits) {
+    bitwidth_t bits = bitsForDecimalDigits(digits.size());
+    SVInt result = bits > BITS_PER_WORD ? allocZeroed(bits, false, false) : SVInt(bits, 0, false);
+    uint64_t* words = result.isSingleWord() ? &result.val : result.pVal;
 
     constexpr int charsPerWord = 18; // 18 decimal digits can fit in a 64-bit word
     const logic_t* d = digits.data();
@@ -276,13 +415,13 @@ SVInt SVInt::fromDecimalDigits(bitwidth_t bits, bool isSigned, std::span<logic_t
     auto writeWord = [&]() {
         if (!count) {
             if (word)
-                result.pVal[count++] = word;
+                words[count++] = word;
         }
         else {
-            uint64_t carry = mulOne(result.pVal, result.pVal, count, maxWord);
-            carry += addOne(result.pVal, result.pVal, count, word);
+            uint64_t carry = mulOne(words, words, count, maxWord);
+            carry += addOne(words, words, count, word);
             if (carry)
-                result.pVal[count++] = carry;
+                words[count++] = carry;
         }
     };
 
@@ -410,6 +549,30 @@ SVInt SVInt::fromFloat(bitwidth_t bits, float value, bool isSigned, bool round)
     return fromIEEE754<float, 8, 23, 127>(bits, value, isSigned, round);
 }
 
+SVInt SVInt::fromRawWords(bitwidth_t bits, bool isSigned, std::span<const uint64_t> value,
+                          std::span<const uint64_t> unknown) {
+    const uint32_t words = getNumWords(bits, false);
+    SLANG_ASSERT(value.size() == words);
+    SLANG_ASSERT(unknown.empty() || unknown.size() == words);
+
+    if (std::ranges::all_of(unknown, [](uint64_t word) { return word == 0; })) {
+        if (bits <= BITS_PER_WORD)
+            return SVInt(bits, value[0], isSigned);
+
+        SVInt result = allocUninitialized(bits, isSigned, false);
+        memcpy(result.pVal, value.data(), words * WORD_SIZE);
+        result.clearUnusedBits();
+        return result;
+    }
+
+    SVInt result = allocUninitialized(bits, isSigned, true);
+    memcpy(result.pVal, value.data(), words * WORD_SIZE);
+    memcpy(result.pVal + words, unknown.data(), words * WORD_SIZE);
+    result.clearUnusedBits();
+    result.checkUnknown();
+    return result;
+}
+
 double SVInt::toDouble() const {
     return toIEEE754<double, 11, 52, 1023>(*this);
 }
@@ -430,10 +593,10 @@ void SVInt::setAllZeros() {
 void SVInt::setAllOnes() {
     // we don't have unknown digits anymore, so reallocate if necessary
     if (unknownFlag) {
+        freeWords(pVal, getNumWords());
         unknownFlag = false;
-        delete[] pVal;
         if (getNumWords() > 1)
-            pVal = new uint64_t[getNumWords()];
+            pVal = allocWords(getNumWords());
     }
 
     if (isSingleWord())
@@ -451,11 +614,9 @@ void SVInt::setAllX() {
     if (unknownFlag)
         memset(pVal, 0, words * WORD_SIZE);
     else {
-        if (!isSingleWord())
-            delete[] pVal;
-
+        freeWords(pVal, getNumWords());
         unknownFlag = true;
-        pVal = new uint64_t[words * 2]();
+        pVal = allocZeroedWords(words * 2);
     }
 
     // now set upper half to ones (for unknown)
@@ -466,11 +627,9 @@ void SVInt::setAllX() {
 
 void SVInt::setAllZ() {
     if (!unknownFlag) {
-        if (!isSingleWord())
-            delete[] pVal;
-
+        freeWords(pVal, getNumWords());
         unknownFlag = true;
-        pVal = new uint64_t[getNumWords()];
+        pVal = allocWords(getNumWords());
     }
 
     // everything set to 1 (for Z in the low half and for unknown in the upper half)
@@ -777,17 +936,18 @@ void SVInt::writeTo(SmallVectorBase<char>& buffer, LiteralBase base, bool includ
                 tmp = quotient;
             }
 
-            // repeatedly divide by 10 to get each digit
-            SVInt divisor(4, 10, false);
-            while (tmp != 0) {
-                SVInt remainder;
-                SVInt quotient;
-                divide(tmp, tmp.getNumWords(), divisor, divisor.getNumWords(), &quotient,
-                       &remainder);
-                uint64_t digit = remainder.as<uint64_t>().value();
-                SLANG_ASSERT(digit < 10);
-                buffer.push_back(Digits[digit]);
-                tmp = quotient;
+            tmp.setSigned(false);
+            if (tmp.getActiveBits() <= DecimalChunkBits) {
+                writeDecimalChunk(buffer, tmp, 0);
+            }
+            else {
+                // Start from the smallest power whose square is larger than the value.
+                DecimalPowers powers;
+                uint32_t level = 0;
+                while (2 * powers.get(level).getBitWidth() - 1 < tmp.getActiveBits())
+                    level++;
+
+                writeDecimalDigits(buffer, powers, level, std::move(tmp), 0);
             }
         }
     }
@@ -842,19 +1002,80 @@ void SVInt::writeTo(SmallVectorBase<char>& buffer, LiteralBase base, bool includ
             bitsLeft -= int(shiftAmount);
             x = tmp != 0;
         }
+
+        // the digits were generated starting from the least significant one
+        std::ranges::reverse(buffer.begin() + startOffset, buffer.end());
     }
 
     // no digits means this is zero
     if (startOffset == buffer.size())
         buffer.push_back('0');
-    else {
-        // reverse the digits
-        std::ranges::reverse(buffer.begin() + startOffset, buffer.end());
-        if (base10Exponent > 0) {
-            buffer.append_range("...e"sv);
-            uintToStr(buffer, base10Exponent);
+    else if (base10Exponent > 0) {
+        buffer.append_range("...e"sv);
+        uintToStr(buffer, base10Exponent);
+    }
+}
+
+void SVInt::writeDecimalDigits(SmallVectorBase<char>& buffer, DecimalPowers& powers,
+                               uint32_t level, SVInt value, size_t minDigits) {
+    // The value must be less than the square of the power at the given level,
+    // which means that both halves are less than the power itself.
+    if (level == 0 || value.getActiveBits() <= DecimalChunkBits) {
+        writeDecimalChunk(buffer, value, minDigits);
+        return;
+    }
+
+    size_t lowDigits = DecimalPowers::numDigits(level);
+    if (value < powers.get(level)) {
+        writeDecimalDigits(buffer, powers, level - 1, std::move(value), minDigits);
+        return;
+    }
+
+    SVInt quotient = powers.divide(level, value);
+    writeDecimalDigits(buffer, powers, level - 1, std::move(quotient),
+                       minDigits > lowDigits ? minDigits - lowDigits : 0);
+    writeDecimalDigits(buffer, powers, level - 1, std::move(value), lowDigits);
+}
+
+void SVInt::writeDecimalChunk(SmallVectorBase<char>& buffer, const SVInt& value,
+                              size_t minDigits) {
+    // Repeatedly divide by 10^9, one 32-bit half word at a time, to get
+    // the digits nine at a time starting from the least significant ones.
+    constexpr uint32_t chunkDivisor = 1'000'000'000;
+    constexpr int chunkDigits = 9;
+
+    uint32_t numWords = getNumWords(value.bitWidth, false);
+    uint32_t len = numWords * 2;
+    TempBuffer<uint32_t, 128> halves(len);
+    splitWords(value, halves.get(), numWords);
+
+    auto data = halves.get();
+    while (len && !data[len - 1])
+        len--;
+
+    size_t startOffset = buffer.size();
+    while (len) {
+        uint64_t rem = 0;
+        for (uint32_t i = len; i > 0; i--) {
+            uint64_t cur = (rem << 32) | data[i - 1];
+            data[i - 1] = uint32_t(cur / chunkDivisor);
+            rem = cur % chunkDivisor;
+        }
+
+        while (len && !data[len - 1])
+            len--;
+
+        // All but the most significant chunk include their leading zeros.
+        for (int i = 0; i < chunkDigits && (len || rem); i++) {
+            buffer.push_back(char('0' + rem % 10));
+            rem /= 10;
         }
     }
+
+    while (buffer.size() - startOffset < minDigits)
+        buffer.push_back('0');
+
+    std::ranges::reverse(buffer.begin() + startOffset, buffer.end());
 }
 
 SVInt SVInt::pow(const SVInt& rhs) const {
@@ -1508,16 +1729,8 @@ void SVInt::set(int32_t msb, int32_t lsb, const SVInt& value) {
     uint32_t backOOB = bitwidth_t(msb) >= bitWidth ? bitwidth_t(msb - int32_t(bitWidth) + 1) : 0;
     uint32_t validSelectWidth = selectWidth - frontOOB - backOOB;
 
-    if (!hasUnknown() && value.hasUnknown()) {
-        uint64_t* newData = new uint64_t[getNumWords(bitWidth, true)]();
-        memcpy(newData, getRawData(), getNumWords());
-
-        if (!isSingleWord())
-            delete[] pVal;
-
-        unknownFlag = true;
-        pVal = newData;
-    }
+    if (!hasUnknown() && value.hasUnknown())
+        makeUnknown();
 
     bitcpy(getRawData(), (uint32_t)std::max(lsb, 0), value.getRawData(), validSelectWidth,
            frontOOB);
@@ -1776,16 +1989,20 @@ SVInt SVInt::concat(std::span<SVInt const> operands) {
 
 SVInt SVInt::allocUninitialized(bitwidth_t bits, bool signFlag, bool unknownFlag) {
     SLANG_ASSERT(bits && (bits > 64 || unknownFlag));
-    return SVInt(new uint64_t[getNumWords(bits, unknownFlag)], bits, signFlag, unknownFlag);
+    SVInt result(nullptr, bits, signFlag, unknownFlag);
+    result.pVal = result.allocWords(result.getNumWords());
+    return result;
 }
 
 SVInt SVInt::allocZeroed(bitwidth_t bits, bool signFlag, bool unknownFlag) {
     SLANG_ASSERT(bits && (bits > 64 || unknownFlag));
-    return SVInt(new uint64_t[getNumWords(bits, unknownFlag)](), bits, signFlag, unknownFlag);
+    SVInt result(nullptr, bits, signFlag, unknownFlag);
+    result.pVal = result.allocZeroedWords(result.getNumWords());
+    return result;
 }
 
 void SVInt::initSlowCase(logic_t bit) {
-    pVal = new uint64_t[getNumWords()](); // allocation is zero cleared
+    pVal = allocZeroedWords(getNumWords());
     pVal[1] = 1;
     if (exactlyEqual(bit, logic_t::z))
         pVal[0] = 1;
@@ -1793,7 +2010,7 @@ void SVInt::initSlowCase(logic_t bit) {
 
 void SVInt::initSlowCase(uint64_t value) {
     uint32_t words = getNumWords();
-    pVal = new uint64_t[words](); // allocation is zero cleared
+    pVal = allocZeroedWords(words);
     pVal[0] = value;
 
     // sign extend if necessary
@@ -1810,7 +2027,7 @@ void SVInt::initSlowCase(std::span<const byte> bytes) {
     }
     else {
         uint32_t words = getNumWords();
-        pVal = new uint64_t[words](); // allocation is zero cleared
+        pVal = allocZeroedWords(words);
         memcpy(pVal, bytes.data(), std::min<size_t>(words * WORD_SIZE, bytes.size()));
     }
     clearUnusedBits();
@@ -1818,7 +2035,7 @@ void SVInt::initSlowCase(std::span<const byte> bytes) {
 
 void SVInt::initSlowCase(const SVIntStorage& other) {
     uint32_t words = getNumWords();
-    pVal = new uint64_t[words];
+    pVal = allocWords(words);
     std::ranges::copy(other.pVal, other.pVal + words, pVal);
 }
 
@@ -1827,16 +2044,16 @@ SVInt& SVInt::assignSlowCase(const SVInt& rhs) {
         return *this;
 
     if (rhs.isSingleWord()) {
-        delete[] pVal;
+        freeWords(pVal, getNumWords());
         val = rhs.val;
     }
     else {
         if (isSingleWord()) {
-            pVal = new uint64_t[rhs.getNumWords()];
+            pVal = allocWords(rhs.getNumWords());
         }
         else if (getNumWords() != rhs.getNumWords()) {
-            delete[] pVal;
-            pVal = new uint64_t[rhs.getNumWords()];
+            freeWords(pVal, getNumWords());
+            pVal = allocWords(rhs.getNumWords());
         }
         memcpy(pVal, rhs.pVal, rhs.getNumWords() * WORD_SIZE);
     }
@@ -2038,13 +2255,13 @@ void SVInt::checkUnknown() {
     uint32_t words = getNumWords();
     if (words == 1) {
         uint64_t newVal = pVal[0];
-        delete[] pVal;
+        freeWords(pVal, 2);
         val = newVal;
     }
     else {
-        uint64_t* newMem = new uint64_t[words];
+        uint64_t* newMem = allocWords(words);
         memcpy(newMem, pVal, words * WORD_SIZE);
-        delete[] pVal;
+        freeWords(pVal, words * 2);
         pVal = newMem;
     }
 }
@@ -2057,14 +2274,14 @@ void SVInt::makeUnknown() {
     unknownFlag = true;
     if (words == 1) {
         auto value = val;
-        pVal = new uint64_t[2];
+        pVal = allocWords(2);
         pVal[0] = value;
         pVal[1] = 0;
     }
     else {
-        uint64_t* newMem = new uint64_t[words * 2]();
+        uint64_t* newMem = allocZeroedWords(words * 2);
         memcpy(newMem, pVal, words * WORD_SIZE);
-        delete[] pVal;
+        freeWords(pVal, words);
         pVal = newMem;
     }
 }
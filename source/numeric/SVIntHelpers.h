@@ -345,6 +345,18 @@ static void mulKaratsuba(uint64_t* dst, const uint64_t* x, uint32_t xlen, const
     }
 
     uint32_t shift = ylen >> 1;
+    if (xlen <= shift) {
+        // The split below needs operands of similar size, so multiply
+        // a much longer operand in pieces the size of the shorter one.
+        memset(dst, 0, (xlen + ylen) * sizeof(uint64_t));
+        TempBuffer<uint64_t, 128> t(xlen * 2);
+        for (uint32_t i = 0; i < ylen; i += xlen) {
+            uint32_t len = std::min(xlen, ylen - i);
+            mul(t.get(), x, xlen, y + i, len);
+            addGeneral(dst + i, dst + i, t.get(), xlen + len);
+        }
+        return;
+    }
 
     uint32_t xlSize = std::min(xlen, shift);
     uint32_t xhSize = xlen - xlSize;
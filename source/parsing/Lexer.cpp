@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 #include "slang/parsing/Lexer.h"
 
+#include <bit>
 #include <cmath>
 #include <fmt/core.h>
 
@@ -19,6 +20,11 @@
 #include "slang/util/ScopeGuard.h"
 #include "slang/util/String.h"
 
+#if defined(__x86_64__) || defined(_M_X64)
+#    include <emmintrin.h>
+#    define SLANG_LEXER_SSE2 1
+#endif
+
 static_assert(std::numeric_limits<double>::is_iec559, "SystemVerilog requires IEEE 754");
 
 static const double BitsPerDecimal = log2(10.0);
@@ -29,6 +35,102 @@ using namespace syntax;
 
 using LF = LexerFacts;
 
+namespace {
+
+// The skip* functions below jump over runs of characters that need no special
+// handling, sixteen at a time, and return a pointer to the first character that
+// the caller's scalar loop needs to look at. They never read past @a end, so they
+// stop early once fewer than sixteen characters remain and leave the rest to the
+// scalar loop as well. Without SSE2 they just return @a ptr.
+#ifdef SLANG_LEXER_SSE2
+
+template<typename TFunc>
+const char* skipChunks(const char* ptr, const char* end, TFunc&& findStops) {
+    while (end - ptr >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        if (uint32_t stops = findStops(chunk))
+            return ptr + std::countr_zero(stops);
+        ptr += 16;
+    }
+    return ptr;
+}
+
+__m128i charEquals(__m128i chunk, char c) {
+    return _mm_cmpeq_epi8(chunk, _mm_set1_epi8(c));
+}
+
+__m128i charInRange(__m128i chunk, char lo, char hi) {
+    // Bytes >= 0x80 compare as negative and so are never in range.
+    return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(char(lo - 1))),
+                         _mm_cmplt_epi8(chunk, _mm_set1_epi8(char(hi + 1))));
+}
+
+// Returns a bit mask of the positions in the chunk that match the given
+// characters, or that are not ASCII.
+template<char... Chars>
+uint32_t findCharsOrNonASCII(__m128i chunk) {
+    __m128i result = _mm_cmplt_epi8(chunk, _mm_setzero_si128());
+    ((result = _mm_or_si128(result, charEquals(chunk, Chars))), ...);
+    return uint32_t(_mm_movemask_epi8(result));
+}
+
+const char* skipIdentifierChars(const char* ptr, const char* end) {
+    return skipChunks(ptr, end, [](__m128i chunk) {
+        __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+        __m128i valid = _mm_or_si128(charInRange(lower, 'a', 'z'), charInRange(chunk, '0', '9'));
+        valid = _mm_or_si128(valid, charEquals(chunk, '_'));
+        valid = _mm_or_si128(valid, charEquals(chunk, '$'));
+        return uint32_t(_mm_movemask_epi8(valid)) ^ 0xffff;
+    });
+}
+
+const char* skipWhitespaceChars(const char* ptr, const char* end) {
+    return skipChunks(ptr, end, [](__m128i chunk) {
+        // '\t', '\v' and '\f' are all in [9, 12], along with '\n' which we exclude.
+        __m128i valid = _mm_andnot_si128(charEquals(chunk, '\n'), charInRange(chunk, '\t', '\f'));
+        valid = _mm_or_si128(valid, charEquals(chunk, ' '));
+        return uint32_t(_mm_movemask_epi8(valid)) ^ 0xffff;
+    });
+}
+
+const char* skipLineCommentChars(const char* ptr, const char* end) {
+    return skipChunks(ptr, end, findCharsOrNonASCII<'\n', '\r', '\0'>);
+}
+
+const char* skipBlockCommentChars(const char* ptr, const char* end) {
+    return skipChunks(ptr, end, findCharsOrNonASCII<'*', '/', '\0'>);
+}
+
+const char* skipStringChars(const char* ptr, const char* end) {
+    return skipChunks(ptr, end, findCharsOrNonASCII<'\\', '"', '\n', '\r', '\0'>);
+}
+
+#else
+
+const char* skipIdentifierChars(const char* ptr, const char*) {
+    return ptr;
+}
+
+const char* skipWhitespaceChars(const char* ptr, const char*) {
+    return ptr;
+}
+
+const char* skipLineCommentChars(const char* ptr, const char*) {
+    return ptr;
+}
+
+const char* skipBlockCommentChars(const char* ptr, const char*) {
+    return ptr;
+}
+
+const char* skipStringChars(const char* ptr, const char*) {
+    return ptr;
+}
+
+#endif
+
+} // namespace
+
 Lexer::Lexer(SourceBuffer buffer, BumpAllocator& alloc, Diagnostics& diagnostics,
              LexerOptions options) :
     Lexer(buffer.id, buffer.data, buffer.data.data(), alloc, diagnostics, options) {
@@ -223,6 +325,11 @@ Token Lexer::lex() {
 }
 
 Token Lexer::lex(KeywordVersion keywordVersion) {
+    if (!prelexedTokens.empty()) {
+        if (auto token = replayToken(keywordVersion))
+            return token;
+    }
+
     triviaBuffer.clear();
     lexTrivia<false>();
 
@@ -243,6 +350,38 @@ Token Lexer::lex(KeywordVersion keywordVersion) {
     return token;
 }
 
+void Lexer::setPrelexedTokens(std::span<const LexedToken> tokens, KeywordVersion keywordVersion) {
+    prelexedTokens = tokens;
+    prelexedIndex = 0;
+    prelexedVersion = keywordVersion;
+}
+
+Token Lexer::replayToken(KeywordVersion keywordVersion) {
+    // Skip any tokens that we've already moved past, which can happen if some
+    // of the text had to be lexed differently than it was originally.
+    const size_t offset = currentOffset();
+    while (prelexedIndex < prelexedTokens.size() &&
+           prelexedTokens[prelexedIndex].startOffset < offset) {
+        prelexedIndex++;
+    }
+
+    if (prelexedIndex == prelexedTokens.size()) {
+        prelexedTokens = {};
+        return Token();
+    }
+
+    // Tokens can only be replayed if they were lexed from exactly the same
+    // position with the same set of keywords.
+    auto& entry = prelexedTokens[prelexedIndex];
+    if (entry.startOffset != offset || keywordVersion != prelexedVersion)
+        return Token();
+
+    prelexedIndex++;
+    sourceBuffer = originalBegin + entry.endOffset;
+    return entry.token.withLocation(alloc,
+                                    SourceLocation(bufferId, entry.token.location().offset()));
+}
+
 bool Lexer::isNextTokenOnSameLine() {
     auto guard = ScopeGuard([this, currBuff = sourceBuffer] { sourceBuffer = currBuff; });
 
@@ -685,6 +824,12 @@ Token Lexer::lexStringLiteral() {
     stringBuffer.clear();
     bool sawUTF8Error = false;
     while (true) {
+        if (auto next = skipStringChars(sourceBuffer, sourceEnd); next != sourceBuffer) {
+            stringBuffer.append(sourceBuffer, next);
+            sourceBuffer = next;
+            sawUTF8Error = false;
+        }
+
         size_t offset = currentOffset();
         char c = peek();
 
@@ -1166,6 +1311,7 @@ void Lexer::lexTrivia() {
 }
 
 void Lexer::scanIdentifier() {
+    sourceBuffer = skipIdentifierChars(sourceBuffer, sourceEnd);
     while (true) {
         char c = peek();
         if (isAlphaNumeric(c) || c == '_' || c == '$')
@@ -1176,6 +1322,8 @@ void Lexer::scanIdentifier() {
 }
 
 void Lexer::scanWhitespace() {
+    sourceBuffer = skipWhitespaceChars(sourceBuffer, sourceEnd);
+
     bool done = false;
     while (!done) {
         switch (peek()) {
@@ -1196,6 +1344,11 @@ void Lexer::scanWhitespace() {
 void Lexer::scanLineComment() {
     bool sawUTF8Error = false;
     while (true) {
+        if (auto next = skipLineCommentChars(sourceBuffer, sourceEnd); next != sourceBuffer) {
+            sourceBuffer = next;
+            sawUTF8Error = false;
+        }
+
         char c = peek();
         if (isASCII(c)) {
             if (isNewline(c))
@@ -1222,6 +1375,11 @@ void Lexer::scanLineComment() {
 void Lexer::scanBlockComment() {
     bool sawUTF8Error = false;
     while (true) {
+        if (auto next = skipBlockCommentChars(sourceBuffer, sourceEnd); next != sourceBuffer) {
+            sourceBuffer = next;
+            sawUTF8Error = false;
+        }
+
         char c = peek();
         if (isASCII(c)) {
             sawUTF8Error = false;
@@ -9,6 +9,7 @@
 
 #include "slang/diagnostics/LexerDiags.h"
 #include "slang/diagnostics/PreprocessorDiags.h"
+#include "slang/parsing/TokenCache.h"
 #include "slang/syntax/AllSyntax.h"
 #include "slang/text/SourceManager.h"
 #include "slang/util/BumpAllocator.h"
@@ -99,12 +100,82 @@ void Preprocessor::pushSource(SourceBuffer buffer) {
     SLANG_ASSERT(buffer.id);
 
     lexerStack.emplace_back(std::make_unique<Lexer>(buffer, alloc, diagnostics, lexerOptions));
+
+    auto& guard = includeGuardStack.emplace_back();
+    guard.fileText = buffer.data.data();
+    guard.buffer = buffer.id;
 }
 
 void Preprocessor::popSource() {
     if (includeDepth)
         includeDepth--;
     lexerStack.pop_back();
+
+    // If the file turned out to be entirely wrapped in an include guard,
+    // remember that so we can skip it if it gets included again.
+    auto& guard = includeGuardStack.back();
+    if (guard.kind == IncludeGuardState::AfterGuard)
+        includeGuardMacros.emplace(guard.fileText, guard.macroName);
+    includeGuardStack.pop_back();
+}
+
+void Preprocessor::beginIncludeGuard(Token directive,
+                                     const ConditionalDirectiveExpressionSyntax& expr) {
+    if (includeGuardStack.empty())
+        return;
+
+    // Only an `ifndef of a single macro name that appears before anything
+    // else in the file can be an include guard.
+    auto& guard = includeGuardStack.back();
+    if (guard.kind == IncludeGuardState::Start &&
+        expr.kind == SyntaxKind::NamedConditionalDirectiveExpression &&
+        directive.location().buffer() == guard.buffer) {
+        guard.kind = IncludeGuardState::InGuard;
+        guard.macroName = expr.as<NamedConditionalDirectiveExpressionSyntax>().name.valueText();
+        guard.branchIndex = branchStack.size();
+    }
+    else {
+        invalidateIncludeGuard();
+    }
+}
+
+void Preprocessor::endIncludeGuardBranch(Token directive) {
+    invalidateIncludeGuard();
+    if (branchStack.empty())
+        return;
+
+    // An `else or `elsif for the guard's branch means it's not really an include guard.
+    // Note that all files in the include stack need to be checked since the directive
+    // might come from a different file than the one that opened the branch.
+    const size_t index = branchStack.size() - 1;
+    for (auto& guard : includeGuardStack) {
+        if (guard.kind == IncludeGuardState::InGuard && guard.branchIndex == index) {
+            if (directive.directiveKind() == SyntaxKind::EndIfDirective &&
+                directive.location().buffer() == guard.buffer) {
+                guard.kind = IncludeGuardState::AfterGuard;
+            }
+            else {
+                guard.kind = IncludeGuardState::NotGuarded;
+            }
+        }
+    }
+}
+
+void Preprocessor::invalidateIncludeGuard() {
+    // Anything in the current file outside of the guarded region
+    // means that the file is not fully guarded.
+    if (!includeGuardStack.empty() &&
+        includeGuardStack.back().kind != IncludeGuardState::InGuard) {
+        includeGuardStack.back().kind = IncludeGuardState::NotGuarded;
+    }
+}
+
+bool Preprocessor::shouldSkipInclude(const char* fileText) const {
+    if (includeOnceHeaders.contains(fileText))
+        return true;
+
+    auto it = includeGuardMacros.find(fileText);
+    return it != includeGuardMacros.end() && macros.contains(it->second);
 }
 
 void Preprocessor::predefine(const std::string& definition, std::string_view name) {
@@ -211,7 +282,10 @@ std::vector<const DefineDirectiveSyntax*> Preprocessor::getDefinedMacros() const
 }
 
 Token Preprocessor::next() {
-    return consume();
+    auto token = consume();
+    if (token.kind != TokenKind::EndOfFile)
+        invalidateIncludeGuard();
+    return token;
 }
 
 Token Preprocessor::nextProcessed() {
@@ -289,6 +363,18 @@ Token Preprocessor::handleDirectives(Token token) {
             }
             case TokenKind::Directive: {
                 auto savedLast = std::exchange(lastConsumed, token);
+                switch (token.directiveKind()) {
+                    case SyntaxKind::IfNDefDirective:
+                    case SyntaxKind::ElsIfDirective:
+                    case SyntaxKind::ElseDirective:
+                    case SyntaxKind::EndIfDirective:
+                        // These are checked for include guards by their handlers.
+                        break;
+                    default:
+                        invalidateIncludeGuard();
+                        break;
+                }
+
                 switch (token.directiveKind()) {
                     case SyntaxKind::IncludeDirective:
                         trivia.push_back(handleIncludeDirective(token));
@@ -525,18 +611,36 @@ Trivia Preprocessor::handleIncludeDirective(Token directive) {
         bool isSystem = path[0] == '<';
         path = path.substr(1, path.length() - 2);
 
-        auto buffer = sourceManager.readHeader(path, directive.location(), getCurrentLibrary(),
-                                               isSystem, options.additionalIncludePaths);
-        if (!buffer) {
-            addDiag(diag::CouldNotOpenIncludeFile, fileName.range())
-                << path << buffer.error().message();
-        }
-        else if (includeDepth >= options.maxIncludeDepth) {
-            addDiag(diag::ExceededMaxIncludeDepth, fileName.range());
-        }
-        else if (includeOnceHeaders.find(buffer->data.data()) == includeOnceHeaders.end()) {
-            includeDepth++;
-            pushSource(*buffer);
+        // If we've already found this file before and know it doesn't need to be
+        // included again, we can skip it without looking it up a second time.
+        auto library = getCurrentLibrary();
+        auto includer = sourceManager.getSourceText(directive.location().buffer()).data();
+        auto cacheKey = std::tuple{path, isSystem, includer, library};
+        if (auto it = includeLookupCache.find(cacheKey);
+            it == includeLookupCache.end() || !shouldSkipInclude(it->second)) {
+
+            auto buffer = sourceManager.readHeader(path, directive.location(), library, isSystem,
+                                                   options.additionalIncludePaths);
+            if (!buffer) {
+                addDiag(diag::CouldNotOpenIncludeFile, fileName.range())
+                    << path << buffer.error().message();
+            }
+            else {
+                includeLookupCache.insert_or_assign(cacheKey, buffer->data.data());
+                if (includeDepth >= options.maxIncludeDepth) {
+                    addDiag(diag::ExceededMaxIncludeDepth, fileName.range());
+                }
+                else if (!shouldSkipInclude(buffer->data.data())) {
+                    includeDepth++;
+                    pushSource(*buffer);
+
+                    if (auto& cache = options.tokenCache) {
+                        auto kv = keywordVersionStack.back();
+                        lexerStack.back()->setPrelexedTokens(
+                            cache->getTokens(*buffer, kv, lexerOptions), kv);
+                    }
+                }
+            }
         }
     }
 
@@ -688,18 +792,23 @@ Trivia Preprocessor::handleIfDefDirective(Token directive, bool inverted) {
             take = !take;
     }
 
+    if (inverted)
+        beginIncludeGuard(directive, expr);
+
     branchStack.emplace_back(BranchEntry(directive, take));
 
     return parseBranchDirective(directive, &expr, take);
 }
 
 Trivia Preprocessor::handleElsIfDirective(Token directive) {
+    endIncludeGuardBranch(directive);
     auto& expr = parseConditionalExprTop();
     bool take = shouldTakeElseBranch(directive.location(), &expr);
     return parseBranchDirective(directive, &expr, take);
 }
 
 Trivia Preprocessor::handleElseDirective(Token directive) {
+    endIncludeGuardBranch(directive);
     bool take = shouldTakeElseBranch(directive.location(), nullptr);
     return parseBranchDirective(directive, nullptr, take);
 }
@@ -785,6 +894,8 @@ Trivia Preprocessor::parseBranchDirective(Token directive,
 }
 
 Trivia Preprocessor::handleEndIfDirective(Token directive) {
+    endIncludeGuardBranch(directive);
+
     // pop the active branch off the stack
     bool taken = true;
     if (branchStack.empty())
@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+// TokenCache.cpp
+// Thread-safe cache of lexed tokens for shared source files
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "slang/parsing/TokenCache.h"
+
+namespace slang::parsing {
+
+std::span<const LexedToken> TokenCache::getTokens(const SourceBuffer& buffer,
+                                                  KeywordVersion keywordVersion,
+                                                  const LexerOptions& options) {
+    // Offsets are stored as 32-bit values so we can't handle enormous files.
+    if (buffer.data.size() > UINT32_MAX)
+        return {};
+
+    Entry* entry;
+    {
+        std::unique_lock lock(mutex);
+        auto& slot = entries[{buffer.data.data(), keywordVersion, options.languageVersion}];
+        if (!slot)
+            slot = std::make_unique<Entry>();
+        entry = slot.get();
+    }
+
+    // The first thread to ask for a file does the lexing; any others
+    // asking for it at the same time wait for that to finish.
+    std::call_once(entry->once, [&] {
+        Diagnostics diagnostics;
+        Lexer lexer(buffer, entry->alloc, diagnostics, options);
+
+        while (true) {
+            auto startOffset = uint32_t(lexer.currentOffset());
+            auto token = lexer.lex(keywordVersion);
+            entry->tokens.push_back({token, startOffset, uint32_t(lexer.currentOffset())});
+            if (token.kind == TokenKind::EndOfFile)
+                break;
+        }
+
+        if (!diagnostics.empty()) {
+            entry->tokens.clear();
+            entry->tokens.shrink_to_fit();
+        }
+    });
+
+    return entry->tokens;
+}
+
+} // namespace slang::parsing
@@ -0,0 +1,661 @@
+//------------------------------------------------------------------------------
+// SyntaxSerializer.cpp
+// Binary serialization of syntax trees
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "slang/syntax/SyntaxSerializer.h"
+
+#include "SyntaxDeserialize.h"
+#include <cstring>
+
+#include "slang/parsing/LexerFacts.h"
+#include "slang/syntax/SyntaxTree.h"
+#include "slang/text/SourceManager.h"
+#include "slang/util/Hash.h"
+
+namespace {
+
+using namespace slang;
+using namespace slang::parsing;
+using namespace slang::syntax;
+
+// The serialized form starts with a fixed size header, followed by the payload.
+// The payload is a pre-order walk of the tree, where every integer is written as
+// a LEB128 varint. Each node starts with its kind (zero for a null node), and then
+// its children in getChild() order; lists also include their child count. Tokens
+// start with their kind (zero for an empty token) followed by their location,
+// trivia, raw text (if not implied by the kind), and any value they carry.
+//
+// After the tree comes the preprocessor state that was in effect for each node
+// in the parser's metadata map, since that can't be recovered from the syntax
+// alone. Nodes are identified by their position in the walk (not counting lists).
+constexpr uint32_t Magic = 0x54535653; // "SVST"
+constexpr uint32_t FormatVersion = 2;
+constexpr size_t HeaderSize = sizeof(uint32_t) * 2 + sizeof(uint64_t);
+
+class Writer {
+public:
+    Writer(SmallVector<char>& output, const SourceBuffer& buffer, const ParserMetadata& metadata) :
+        output(output), buffer(buffer), metadata(metadata) {}
+
+    bool failed = false;
+
+    void writeNode(const SyntaxNode* node) {
+        if (!node || failed) {
+            writeVar(0);
+            return;
+        }
+
+        writeVar(uint64_t(node->kind));
+        switch (node->kind) {
+            case SyntaxKind::SyntaxList: {
+                auto& list = node->as<SyntaxListBase>();
+                writeVar(list.getChildCount());
+                for (size_t i = 0; i < list.getChildCount(); i++)
+                    writeNode(list.getChild(i).node());
+                break;
+            }
+            case SyntaxKind::TokenList: {
+                auto& list = node->as<SyntaxListBase>();
+                writeVar(list.getChildCount());
+                for (size_t i = 0; i < list.getChildCount(); i++)
+                    writeToken(list.getChild(i).token());
+                break;
+            }
+            case SyntaxKind::SeparatedList: {
+                // Elements alternate between nodes and separator tokens.
+                auto& list = node->as<SyntaxListBase>();
+                writeVar(list.getChildCount());
+                for (size_t i = 0; i < list.getChildCount(); i++) {
+                    auto child = list.getChild(i);
+                    if (i % 2 == 0)
+                        writeNode(child.node());
+                    else
+                        writeToken(child.token());
+                }
+                break;
+            }
+            default: {
+                auto it = metadata.nodeMap.find(node);
+                if (it != metadata.nodeMap.end())
+                    nodeMeta.emplace_back(nodeCount, it->second);
+                nodeCount++;
+
+                // A child that is neither a node nor a valid token is written
+                // as a zero, which reads back correctly as either one.
+                for (size_t i = 0; i < node->getChildCount(); i++) {
+                    if (auto child = node->childNode(i))
+                        writeNode(child);
+                    else
+                        writeToken(node->childToken(i));
+                }
+                break;
+            }
+        }
+    }
+
+    void writeMetadata() {
+        writeVar(nodeMeta.size());
+        for (auto& [index, meta] : nodeMeta) {
+            writeVar(index);
+            writeVar(uint64_t(meta.defaultNetType));
+            writeVar(uint64_t(meta.unconnectedDrive));
+            writeVar(meta.timeScale.has_value());
+            if (meta.timeScale) {
+                writeTimeScaleValue(meta.timeScale->base);
+                writeTimeScaleValue(meta.timeScale->precision);
+            }
+        }
+    }
+
+private:
+    SmallVector<char>& output;
+    const SourceBuffer& buffer;
+    const ParserMetadata& metadata;
+    SmallVector<std::pair<size_t, ParserMetadata::Node>> nodeMeta;
+    size_t nodeCount = 0;
+
+    void writeVar(uint64_t value) {
+        while (value >= 0x80) {
+            output.push_back(char(value | 0x80));
+            value >>= 7;
+        }
+        output.push_back(char(value));
+    }
+
+    void writeText(std::string_view text) {
+        writeVar(text.size());
+        if (text.empty())
+            return;
+
+        // Almost all text points directly into the source buffer, in which
+        // case we only need to store its offset. Otherwise copy it inline.
+        auto& data = buffer.data;
+        if (text.data() >= data.data() && text.data() + text.size() <= data.data() + data.size()) {
+            writeVar(uint64_t(text.data() - data.data()) << 1);
+        }
+        else {
+            writeVar(1);
+            output.append(text.begin(), text.end());
+        }
+    }
+
+    void writeTimeScaleValue(TimeScaleValue value) {
+        writeVar(uint64_t(value.unit));
+        writeVar(uint64_t(value.magnitude));
+    }
+
+    void writeLocation(SourceLocation location) {
+        if (location.buffer() != buffer.id) {
+            failed = true;
+            return;
+        }
+        writeVar(location.offset());
+    }
+
+    void writeTrivia(const Trivia& trivia) {
+        writeVar(uint64_t(trivia.kind));
+        switch (trivia.kind) {
+            case TriviaKind::Directive:
+                switch (trivia.syntax()->kind) {
+                    // These all either pull in tokens from other buffers or
+                    // register extra state with the SourceManager, neither of
+                    // which we can restore.
+                    case SyntaxKind::IncludeDirective:
+                    case SyntaxKind::LineDirective:
+                    case SyntaxKind::PragmaDirective:
+                    case SyntaxKind::MacroUsage:
+                        failed = true;
+                        return;
+                    default:
+                        break;
+                }
+                writeNode(trivia.syntax());
+                break;
+            case TriviaKind::SkippedSyntax:
+                writeNode(trivia.syntax());
+                break;
+            case TriviaKind::SkippedTokens: {
+                auto tokens = trivia.getSkippedTokens();
+                writeVar(tokens.size());
+                for (auto token : tokens)
+                    writeToken(token);
+                break;
+            }
+            default:
+                if (trivia.getExplicitLocation()) {
+                    failed = true;
+                    return;
+                }
+                writeText(trivia.getRawText());
+                break;
+        }
+    }
+
+    void writeToken(Token token) {
+        if (!token || failed) {
+            writeVar(0);
+            return;
+        }
+
+        if (token.kind == TokenKind::Unknown || token.isMissing()) {
+            failed = true;
+            return;
+        }
+
+        writeVar(uint64_t(token.kind));
+        writeLocation(token.location());
+
+        auto trivia = token.trivia();
+        writeVar(trivia.size());
+        for (auto& t : trivia)
+            writeTrivia(t);
+
+        if (LexerFacts::getTokenKindText(token.kind).empty())
+            writeText(token.rawText());
+
+        switch (token.kind) {
+            case TokenKind::StringLiteral:
+                writeText(token.valueText());
+                break;
+            case TokenKind::IntegerLiteral: {
+                auto value = token.intValue();
+                writeVar(value.getBitWidth());
+                writeVar(uint64_t(value.isSigned()) | (uint64_t(value.hasUnknown()) << 1));
+
+                auto words = value.getRawPtr();
+                writeVar(value.getNumWords());
+                for (uint32_t i = 0; i < value.getNumWords(); i++)
+                    writeVar(words[i]);
+                break;
+            }
+            case TokenKind::IntegerBase:
+                writeVar(token.numericFlags().raw);
+                break;
+            case TokenKind::RealLiteral:
+            case TokenKind::TimeLiteral: {
+                double value = token.realValue();
+                uint64_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+                writeVar(bits);
+                writeVar(token.numericFlags().raw);
+                break;
+            }
+            case TokenKind::UnbasedUnsizedLiteral:
+                writeVar(token.bitValue().value);
+                break;
+            case TokenKind::Directive:
+                writeVar(uint64_t(token.directiveKind()));
+                break;
+            case TokenKind::IncludeFileName:
+            case TokenKind::MacroUsage:
+                failed = true;
+                break;
+            default:
+                break;
+        }
+    }
+};
+
+class Reader {
+public:
+    Reader(std::span<const char> data, const SourceBuffer& buffer, BumpAllocator& alloc) :
+        ptr(data.data()), end(data.data() + data.size()), buffer(buffer), alloc(alloc) {}
+
+    bool failed = false;
+
+    bool atEnd() const { return ptr == end; }
+
+    // Once any read fails, all further reads return null nodes and empty tokens
+    // and lists, and the generated code stops as soon as a required node is missing,
+    // so a malformed stream never produces a partially constructed node.
+    SyntaxNode* readAnyNode() {
+        auto kind = SyntaxKind(readVar());
+        if (kind == SyntaxKind::Unknown || failed)
+            return nullptr;
+
+        if (size_t(kind) >= SyntaxKind_traits::values.size()) {
+            failed = true;
+            return nullptr;
+        }
+
+        size_t index = nodes.size();
+        nodes.push_back(nullptr);
+
+        auto result = syntax::detail::deserializeNode(kind, *this, alloc);
+        if (!result || failed) {
+            failed = true;
+            return nullptr;
+        }
+
+        nodes[index] = result;
+        return result;
+    }
+
+    template<typename T>
+    T* readNode() {
+        auto node = readOptionalNode<T>();
+        if (!node)
+            failed = true;
+        return node;
+    }
+
+    template<typename T>
+    T* readOptionalNode() {
+        auto node = readAnyNode();
+        if (!node)
+            return nullptr;
+
+        if (!T::isKind(node->kind)) {
+            failed = true;
+            return nullptr;
+        }
+        return &node->as<T>();
+    }
+
+    template<typename T>
+    SyntaxList<T> readList() {
+        size_t count = readListHeader(SyntaxKind::SyntaxList);
+        SmallVector<T*> buffer(count, UninitializedTag());
+        for (size_t i = 0; i < count; i++) {
+            auto node = readNode<T>();
+            if (!node)
+                return nullptr;
+            buffer.push_back(node);
+        }
+
+        return buffer.copy(alloc);
+    }
+
+    template<typename T>
+    SeparatedSyntaxList<T> readSeparatedList() {
+        size_t count = readListHeader(SyntaxKind::SeparatedList);
+        SmallVector<TokenOrSyntax> buffer(count, UninitializedTag());
+        for (size_t i = 0; i < count; i++) {
+            if (i % 2 == 0) {
+                auto node = readNode<T>();
+                if (!node)
+                    return nullptr;
+                buffer.push_back(node);
+            }
+            else {
+                buffer.push_back(readToken());
+            }
+        }
+
+        return buffer.copy(alloc);
+    }
+
+    TokenList readTokenList() {
+        size_t count = readListHeader(SyntaxKind::TokenList);
+        SmallVector<Token> buffer(count, UninitializedTag());
+        for (size_t i = 0; i < count && !failed; i++)
+            buffer.push_back(readToken());
+
+        return buffer.copy(alloc);
+    }
+
+    Token readToken() {
+        auto kind = TokenKind(readVar());
+        if (kind == TokenKind::Unknown || failed)
+            return Token();
+
+        size_t offset = readVar();
+        if (size_t(kind) >= TokenKind_traits::values.size() || offset > buffer.data.size()) {
+            failed = true;
+            return Token();
+        }
+
+        auto location = SourceLocation(buffer.id, offset);
+
+        size_t triviaCount = readVar();
+        SmallVector<Trivia> triviaBuffer(std::min(triviaCount, size_t(end - ptr)),
+                                         UninitializedTag());
+        for (size_t i = 0; i < triviaCount && !failed; i++)
+            triviaBuffer.push_back(readTrivia());
+
+        std::span<const Trivia> trivia;
+        if (!triviaBuffer.empty())
+            trivia = triviaBuffer.copy(alloc);
+
+        std::string_view rawText = LexerFacts::getTokenKindText(kind);
+        if (rawText.empty())
+            rawText = readText();
+
+        switch (kind) {
+            case TokenKind::StringLiteral:
+                return Token(alloc, kind, trivia, rawText, location, readText());
+            case TokenKind::IntegerLiteral: {
+                auto bitWidth = readVar();
+                auto flags = readVar();
+                size_t numWords = readVar();
+
+                // The word count must match what SVInt expects for the width.
+                size_t expectedWords = size_t(bitWidth + 63) / 64;
+                if (flags & 2)
+                    expectedWords *= 2;
+
+                if (bitWidth == 0 || bitWidth > SVInt::MAX_BITS || flags > 3 ||
+                    numWords != expectedWords || failed) {
+                    failed = true;
+                    return Token();
+                }
+
+                SVIntStorage storage(bitwidth_t(bitWidth), (flags & 1) != 0, (flags & 2) != 0);
+                if (numWords == 1) {
+                    storage.val = readVar();
+                    return Token(alloc, kind, trivia, rawText, location, SVInt(storage));
+                }
+
+                SmallVector<uint64_t> words(std::min(numWords, size_t(end - ptr)),
+                                            UninitializedTag());
+                for (size_t i = 0; i < numWords && !failed; i++)
+                    words.push_back(readVar());
+
+                if (failed)
+                    return Token();
+
+                storage.pVal = words.data();
+                return Token(alloc, kind, trivia, rawText, location, SVInt(storage));
+            }
+            case TokenKind::IntegerBase: {
+                NumericTokenFlags flags{uint8_t(readVar())};
+                return Token(alloc, kind, trivia, rawText, location, flags.base(),
+                             flags.isSigned());
+            }
+            case TokenKind::RealLiteral:
+            case TokenKind::TimeLiteral: {
+                uint64_t bits = readVar();
+                double value;
+                memcpy(&value, &bits, sizeof(value));
+
+                NumericTokenFlags flags{uint8_t(readVar())};
+                std::optional<TimeUnit> unit;
+                if (kind == TokenKind::TimeLiteral)
+                    unit = flags.unit();
+
+                return Token(alloc, kind, trivia, rawText, location, value, flags.outOfRange(),
+                             unit);
+            }
+            case TokenKind::UnbasedUnsizedLiteral:
+                return Token(alloc, kind, trivia, rawText, location, logic_t(uint8_t(readVar())));
+            case TokenKind::Directive: {
+                auto directive = readVar();
+                if (directive >= SyntaxKind_traits::values.size()) {
+                    failed = true;
+                    return Token();
+                }
+                return Token(alloc, kind, trivia, rawText, location, SyntaxKind(directive));
+            }
+            default:
+                return Token(alloc, kind, trivia, rawText, location);
+        }
+    }
+
+    void readMetadata(ParserMetadata& metadata) {
+        size_t count = readVar();
+        for (size_t i = 0; i < count && !failed; i++) {
+            size_t index = readVar();
+            auto netType = readTokenKind();
+            auto unconnectedDrive = readTokenKind();
+
+            std::optional<TimeScale> timeScale;
+            if (readVar()) {
+                auto base = readTimeScaleValue();
+                auto precision = readTimeScaleValue();
+                timeScale = TimeScale(base, precision);
+            }
+
+            if (index >= nodes.size() || failed) {
+                failed = true;
+                return;
+            }
+            metadata.nodeMap[nodes[index]] = {netType, unconnectedDrive, timeScale};
+        }
+    }
+
+private:
+    const char* ptr;
+    const char* end;
+    const SourceBuffer& buffer;
+    BumpAllocator& alloc;
+    std::vector<SyntaxNode*> nodes;
+
+    uint64_t readVar() {
+        uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (ptr == end) {
+                failed = true;
+                return 0;
+            }
+
+            auto byte = uint8_t(*ptr++);
+            result |= uint64_t(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+                return result;
+        }
+
+        failed = true;
+        return 0;
+    }
+
+    TokenKind readTokenKind() {
+        auto kind = readVar();
+        if (kind >= TokenKind_traits::values.size()) {
+            failed = true;
+            return TokenKind::Unknown;
+        }
+        return TokenKind(kind);
+    }
+
+    TimeScaleValue readTimeScaleValue() {
+        auto unit = readVar();
+        auto magnitude = TimeScaleMagnitude(readVar());
+        if (unit >= TimeUnit_traits::values.size() ||
+            (magnitude != TimeScaleMagnitude::One && magnitude != TimeScaleMagnitude::Ten &&
+             magnitude != TimeScaleMagnitude::Hundred)) {
+            failed = true;
+            return {};
+        }
+        return TimeScaleValue(TimeUnit(unit), magnitude);
+    }
+
+    std::string_view readText() {
+        size_t size = readVar();
+        if (size == 0)
+            return {};
+
+        uint64_t ref = readVar();
+        if ((ref & 1) == 0) {
+            size_t offset = ref >> 1;
+            if (offset > buffer.data.size() || size > buffer.data.size() - offset) {
+                failed = true;
+                return {};
+            }
+            return buffer.data.substr(offset, size);
+        }
+
+        if (size > size_t(end - ptr)) {
+            failed = true;
+            return {};
+        }
+
+        auto mem = (char*)alloc.allocate(size, 1);
+        memcpy(mem, ptr, size);
+        ptr += size;
+        return std::string_view(mem, size);
+    }
+
+    Trivia readTrivia() {
+        auto kind = TriviaKind(readVar());
+        if (kind == TriviaKind::Unknown || size_t(kind) >= TriviaKind_traits::values.size()) {
+            failed = true;
+            return Trivia();
+        }
+
+        switch (kind) {
+            case TriviaKind::Directive:
+            case TriviaKind::SkippedSyntax: {
+                auto node = readNode<SyntaxNode>();
+                if (!node)
+                    return Trivia();
+                return Trivia(kind, node);
+            }
+            case TriviaKind::SkippedTokens: {
+                size_t count = readVar();
+                SmallVector<Token> tokens(std::min(count, size_t(end - ptr)), UninitializedTag());
+                for (size_t i = 0; i < count && !failed; i++)
+                    tokens.push_back(readToken());
+                return Trivia(kind, tokens.copy(alloc));
+            }
+            default:
+                return Trivia(kind, readText());
+        }
+    }
+
+    size_t readListHeader(SyntaxKind expected) {
+        if (SyntaxKind(readVar()) != expected)
+            failed = true;
+
+        // Every element takes up at least one byte, which gives us
+        // an easy sanity check on the count.
+        size_t count = readVar();
+        if (failed || count > size_t(end - ptr)) {
+            failed = true;
+            return 0;
+        }
+        return count;
+    }
+};
+
+} // namespace
+
+namespace slang::syntax {
+
+bool SyntaxSerializer::serialize(const SyntaxTree& tree, const SourceBuffer& buffer,
+                                 SmallVector<char>& output) {
+    if (!tree.diagnosticsBuffer.empty())
+        return false;
+
+    // Leave room for the header, which we fill in once we know the payload hash.
+    const size_t start = output.size();
+    output.resize(start + HeaderSize);
+
+    Writer writer(output, buffer, tree.getMetadata());
+    writer.writeNode(&tree.root());
+    writer.writeMetadata();
+    if (writer.failed)
+        return false;
+
+    uint64_t hash = slang::detail::hashing::hash(output.data() + start + HeaderSize,
+                                          output.size() - start - HeaderSize);
+
+    char* header = output.data() + start;
+    memcpy(header, &Magic, sizeof(Magic));
+    memcpy(header + sizeof(Magic), &FormatVersion, sizeof(FormatVersion));
+    memcpy(header + sizeof(Magic) + sizeof(FormatVersion), &hash, sizeof(hash));
+    return true;
+}
+
+std::shared_ptr<SyntaxTree> SyntaxSerializer::deserialize(std::span<const char> data,
+                                                          const SourceBuffer& buffer,
+                                                          SourceManager& sourceManager,
+                                                          const Bag& options) {
+    if (data.size() < HeaderSize)
+        return nullptr;
+
+    uint32_t magic, version;
+    uint64_t hash;
+    memcpy(&magic, data.data(), sizeof(magic));
+    memcpy(&version, data.data() + sizeof(magic), sizeof(version));
+    memcpy(&hash, data.data() + sizeof(magic) + sizeof(version), sizeof(hash));
+
+    // The hash check catches most truncated or corrupted files up front, but
+    // the reader still validates everything it reads since the hash is not
+    // a guarantee against a stream that is otherwise malformed.
+    auto payload = data.subspan(HeaderSize);
+    if (magic != Magic || version != FormatVersion ||
+        hash != slang::detail::hashing::hash(payload.data(), payload.size())) {
+        return nullptr;
+    }
+
+    BumpAllocator alloc;
+    Reader reader(payload, buffer, alloc);
+    auto root = reader.readAnyNode();
+    if (!root || reader.failed)
+        return nullptr;
+
+    // Everything other than the preprocessor state can be recomputed from the tree.
+    auto metadata = parsing::ParserMetadata::fromSyntax(*root);
+    metadata.nodeMap.clear();
+    reader.readMetadata(metadata);
+    if (reader.failed || !reader.atEnd())
+        return nullptr;
+    return std::shared_ptr<SyntaxTree>(new SyntaxTree(root, buffer.library, sourceManager,
+                                                      std::move(alloc), Diagnostics(),
+                                                      std::move(metadata), {}, options));
+}
+
+} // namespace slang::syntax
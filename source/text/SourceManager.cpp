@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 #include "slang/text/SourceManager.h"
 
+#include <bit>
 #include <string>
 
 #include "slang/text/Glob.h"
@@ -19,10 +20,65 @@ namespace slang {
 
 static const fs::path emptyPath;
 
+SourceManager::FileData::FileData(const fs::path* directory, std::string name,
+                                  SmallVector<char>&& data, std::unique_ptr<MappedFile>&& mapped,
+                                  fs::path fullPath) :
+    name(std::move(name)), mem(std::move(data)), mapping(std::move(mapped)),
+    text(mapping ? mapping->data() : std::string_view(mem.data(), mem.size())),
+    directory(directory), fullPath(std::move(fullPath)) {
+}
+
+SourceManager::FileData::~FileData() = default;
+
+SourceManager::BufferEntryList::~BufferEntryList() {
+    size_t remaining = count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < MaxChunks; i++) {
+        auto chunk = chunks[i].load(std::memory_order_relaxed);
+        if (!chunk)
+            break;
+
+        size_t numEntries = std::min(remaining, FirstChunkSize << i);
+        std::destroy_n(chunk, numEntries);
+        remaining -= numEntries;
+        ::operator delete(chunk);
+    }
+}
+
+size_t SourceManager::BufferEntryList::chunkIndex(size_t index) {
+    // Chunk N holds FirstChunkSize << N entries, starting at chunkStart(N).
+    return size_t(std::bit_width(index / FirstChunkSize + 1)) - 1;
+}
+
+const SourceManager::BufferEntry& SourceManager::BufferEntryList::operator[](size_t index) const {
+    SLANG_ASSERT(index < size());
+    size_t chunk = chunkIndex(index);
+    return chunks[chunk].load(std::memory_order_acquire)[index - chunkStart(chunk)];
+}
+
+template<typename T, typename... Args>
+size_t SourceManager::BufferEntryList::emplace_back(Args&&... args) {
+    size_t index = count.load(std::memory_order_relaxed);
+    size_t chunk = chunkIndex(index);
+    SLANG_ASSERT(chunk < MaxChunks);
+
+    auto entries = chunks[chunk].load(std::memory_order_relaxed);
+    if (!entries) {
+        entries = static_cast<BufferEntry*>(
+            ::operator new(sizeof(BufferEntry) * (FirstChunkSize << chunk)));
+        chunks[chunk].store(entries, std::memory_order_release);
+    }
+
+    new (entries + (index - chunkStart(chunk)))
+        BufferEntry(std::in_place_type<T>, std::forward<Args>(args)...);
+
+    // Publish the new entry only once it's fully constructed.
+    count.store(index + 1, std::memory_order_release);
+    return index;
+}
+
 SourceManager::SourceManager() {
     // add a dummy entry to the start of the directory list so that our file IDs line up
-    FileInfo file;
-    bufferEntries.emplace_back(file);
+    bufferEntries.emplace_back<FileInfo>();
 }
 
 std::error_code SourceManager::addSystemDirectories(std::string_view pattern) {
@@ -48,14 +104,16 @@ std::error_code SourceManager::addUserDirectories(std::string_view pattern) {
 }
 
 size_t SourceManager::getLineNumber(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    SourceLocation fileLocation = getFullyExpandedLocImpl(location, lock);
-    size_t rawLineNumber = getRawLineNumber(fileLocation, lock);
+    SourceLocation fileLocation = getFullyExpandedLocImpl(location);
+    size_t rawLineNumber = getRawLineNumber(fileLocation);
     if (rawLineNumber == 0)
         return 0;
 
-    auto info = getFileInfo(fileLocation.buffer(), lock);
+    auto info = getFileInfo(fileLocation.buffer());
+    if (!info->hasLineDirectives.load(std::memory_order_acquire))
+        return rawLineNumber;
 
+    std::shared_lock lock(mutex);
     auto lineDirective = info->getPreviousLineDirective(rawLineNumber);
     if (!lineDirective)
         return rawLineNumber;
@@ -64,33 +122,33 @@ size_t SourceManager::getLineNumber(SourceLocation location) const {
 }
 
 size_t SourceManager::getColumnNumber(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(location.buffer(), lock);
+    auto info = getFileInfo(location.buffer());
     if (!info || !info->data)
         return 0;
 
     // walk backward to find start of line
     auto fd = info->data;
     size_t lineStart = location.offset();
-    SLANG_ASSERT(lineStart < fd->mem.size());
-    while (lineStart > 0 && fd->mem[lineStart - 1] != '\n' && fd->mem[lineStart - 1] != '\r')
+    SLANG_ASSERT(lineStart < fd->text.size());
+    while (lineStart > 0 && fd->text[lineStart - 1] != '\n' && fd->text[lineStart - 1] != '\r')
         lineStart--;
 
     return location.offset() - lineStart + 1;
 }
 
 std::string_view SourceManager::getFileName(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    SourceLocation fileLocation = getFullyExpandedLocImpl(location, lock);
-    auto info = getFileInfo(fileLocation.buffer(), lock);
+    SourceLocation fileLocation = getFullyExpandedLocImpl(location);
+    auto info = getFileInfo(fileLocation.buffer());
     if (!info || !info->data)
         return "";
 
     // Avoid computing line offsets if we just need a name of `line-less file
-    if (info->lineDirectives.empty())
+    if (!info->hasLineDirectives.load(std::memory_order_acquire))
         return info->data->name;
 
-    size_t rawLine = getRawLineNumber(fileLocation, lock);
+    size_t rawLine = getRawLineNumber(fileLocation);
+
+    std::shared_lock lock(mutex);
     auto lineDirective = info->getPreviousLineDirective(rawLine);
     if (!lineDirective)
         return info->data->name;
@@ -99,8 +157,7 @@ std::string_view SourceManager::getFileName(SourceLocation location) const {
 }
 
 std::string_view SourceManager::getRawFileName(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info || !info->data)
         return "";
 
@@ -108,8 +165,7 @@ std::string_view SourceManager::getRawFileName(BufferID buffer) const {
 }
 
 const fs::path& SourceManager::getFullPath(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info || !info->data)
         return emptyPath;
 
@@ -117,8 +173,7 @@ const fs::path& SourceManager::getFullPath(BufferID buffer) const {
 }
 
 SourceLocation SourceManager::getIncludedFrom(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info)
         return SourceLocation();
 
@@ -126,8 +181,7 @@ SourceLocation SourceManager::getIncludedFrom(BufferID buffer) const {
 }
 
 const SourceLibrary* SourceManager::getLibraryFor(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info)
         return nullptr;
 
@@ -135,9 +189,8 @@ const SourceLibrary* SourceManager::getLibraryFor(BufferID buffer) const {
 }
 
 std::string_view SourceManager::getMacroName(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    while (isMacroArgLocImpl(location, lock))
-        location = getExpansionRangeImpl(location, lock).start();
+    while (isMacroArgLocImpl(location))
+        location = getExpansionRangeImpl(location).start();
 
     auto buffer = location.buffer();
     if (!buffer)
@@ -155,18 +208,15 @@ bool SourceManager::isFileLoc(SourceLocation location) const {
     if (location.buffer() == SourceLocation::NoLocation.buffer())
         return false;
 
-    std::shared_lock lock(mutex);
-    return getFileInfo(location.buffer(), lock) != nullptr;
+    return getFileInfo(location.buffer()) != nullptr;
 }
 
 bool SourceManager::isMacroLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return isMacroLocImpl(location, lock);
+    return isMacroLocImpl(location);
 }
 
 bool SourceManager::isMacroArgLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return isMacroArgLocImpl(location, lock);
+    return isMacroArgLocImpl(location);
 }
 
 bool SourceManager::isIncludedFileLoc(SourceLocation location) const {
@@ -178,45 +228,37 @@ bool SourceManager::isPreprocessedLoc(SourceLocation location) const {
 }
 
 SourceLocation SourceManager::getExpansionLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return getExpansionRangeImpl(location, lock).start();
+    return getExpansionRangeImpl(location).start();
 }
 
 SourceRange SourceManager::getExpansionRange(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return getExpansionRangeImpl(location, lock);
+    return getExpansionRangeImpl(location);
 }
 
 SourceLocation SourceManager::getOriginalLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return getOriginalLocImpl(location, lock);
+    return getOriginalLocImpl(location);
 }
 
 SourceLocation SourceManager::getFullyOriginalLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    while (isMacroLocImpl(location, lock))
-        location = getOriginalLocImpl(location, lock);
+    while (isMacroLocImpl(location))
+        location = getOriginalLocImpl(location);
     return location;
 }
 
 SourceLocation SourceManager::getFullyExpandedLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return getFullyExpandedLocImpl(location, lock);
+    return getFullyExpandedLocImpl(location);
 }
 
 std::string_view SourceManager::getSourceText(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info || !info->data)
         return "";
 
-    auto fd = info->data;
-    return std::string_view(fd->mem.data(), fd->mem.size());
+    return info->data->text;
 }
 
 uint64_t SourceManager::getSortKey(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info)
         return uint64_t(buffer.getId()) << 32;
 
@@ -227,8 +269,9 @@ SourceLocation SourceManager::createExpansionLoc(SourceLocation originalLoc,
                                                  SourceRange expansionRange, bool isMacroArg) {
     std::unique_lock lock(mutex);
 
-    bufferEntries.emplace_back(ExpansionInfo(originalLoc, expansionRange, isMacroArg));
-    return SourceLocation(BufferID((uint32_t)(bufferEntries.size() - 1), ""sv), 0);
+    size_t index = bufferEntries.emplace_back<ExpansionInfo>(originalLoc, expansionRange,
+                                                             isMacroArg);
+    return SourceLocation(BufferID((uint32_t)index, ""sv), 0);
 }
 
 SourceLocation SourceManager::createExpansionLoc(SourceLocation originalLoc,
@@ -236,8 +279,9 @@ SourceLocation SourceManager::createExpansionLoc(SourceLocation originalLoc,
                                                  std::string_view macroName) {
     std::unique_lock lock(mutex);
 
-    bufferEntries.emplace_back(ExpansionInfo(originalLoc, expansionRange, macroName));
-    return SourceLocation(BufferID((uint32_t)(bufferEntries.size() - 1), macroName), 0);
+    size_t index = bufferEntries.emplace_back<ExpansionInfo>(originalLoc, expansionRange,
+                                                             macroName);
+    return SourceLocation(BufferID((uint32_t)index, macroName), 0);
 }
 
 SourceBuffer SourceManager::assignText(std::string_view text, SourceLocation includedFrom,
@@ -278,7 +322,7 @@ SourceBuffer SourceManager::assignBuffer(std::string_view bufferPath, SmallVecto
     }
 
     return cacheBuffer(std::move(path), std::move(pathStr), includedFrom, library, UINT64_MAX,
-                       std::move(buffer));
+                       std::move(buffer), nullptr);
 }
 
 SourceManager::BufferOrError SourceManager::readSource(const fs::path& path,
@@ -313,12 +357,8 @@ SourceManager::BufferOrError SourceManager::readHeader(
 
     // search relative to the current file
     const fs::path* currFileDir = nullptr;
-    {
-        std::shared_lock lock(mutex);
-        auto info = getFileInfo(includedFrom.buffer(), lock);
-        if (info && info->data)
-            currFileDir = info->data->directory;
-    }
+    if (auto info = getFileInfo(includedFrom.buffer()); info && info->data)
+        currFileDir = info->data->directory;
 
     if (currFileDir) {
         auto result = openCached(*currFileDir / p, includedFrom, library);
@@ -355,8 +395,8 @@ SourceManager::BufferOrError SourceManager::readHeader(
 void SourceManager::addLineDirective(SourceLocation location, size_t lineNum, std::string_view name,
                                      uint8_t level) {
     std::unique_lock lock(mutex);
-    SourceLocation fileLocation = getFullyExpandedLocImpl(location, lock);
-    FileInfo* info = getFileInfo(fileLocation.buffer(), lock);
+    SourceLocation fileLocation = getFullyExpandedLocImpl(location);
+    FileInfo* info = getFileInfo(fileLocation.buffer());
     if (!info || !info->data)
         return;
 
@@ -368,14 +408,15 @@ void SourceManager::addLineDirective(SourceLocation location, size_t lineNum, st
     else
         full = fs::path(info->data->name).replace_filename(linePath);
 
-    size_t sourceLineNum = getRawLineNumber(fileLocation, lock);
+    size_t sourceLineNum = getRawLineNumber(fileLocation);
     info->lineDirectives.emplace_back(std::string(getU8Str(full)), sourceLineNum, lineNum, level);
+    info->hasLineDirectives.store(true, std::memory_order_release);
 }
 
 void SourceManager::addDiagnosticDirective(SourceLocation location, std::string_view name,
                                            DiagnosticSeverity severity) {
     std::unique_lock lock(mutex);
-    SourceLocation fileLocation = getFullyExpandedLocImpl(location, lock);
+    SourceLocation fileLocation = getFullyExpandedLocImpl(location);
 
     size_t offset = fileLocation.offset();
     auto& vec = diagDirectives[fileLocation.buffer()];
@@ -398,24 +439,22 @@ std::span<const SourceManager::DiagnosticDirectiveInfo> SourceManager::getDiagno
 }
 
 std::vector<BufferID> SourceManager::getAllBuffers() const {
-    std::shared_lock lock(mutex);
     std::vector<BufferID> result;
-    for (size_t i = 1; i < bufferEntries.size(); i++)
+    const size_t size = bufferEntries.size();
+    for (size_t i = 1; i < size; i++)
         result.push_back(BufferID((uint32_t)i, ""sv));
 
     return result;
 }
 
-template<IsLock TLock>
-SourceManager::FileInfo* SourceManager::getFileInfo(BufferID buffer, TLock&) {
+SourceManager::FileInfo* SourceManager::getFileInfo(BufferID buffer) {
     if (!buffer || buffer.getId() >= bufferEntries.size())
         return nullptr;
 
     return std::get_if<FileInfo>(&bufferEntries[buffer.getId()]);
 }
 
-template<IsLock TLock>
-const SourceManager::FileInfo* SourceManager::getFileInfo(BufferID buffer, TLock&) const {
+const SourceManager::FileInfo* SourceManager::getFileInfo(BufferID buffer) const {
     if (!buffer || buffer.getId() >= bufferEntries.size())
         return nullptr;
 
@@ -432,9 +471,8 @@ SourceBuffer SourceManager::createBufferEntry(FileData* fd, SourceLocation inclu
     if (sortKey == UINT64_MAX)
         sortKey = bufferEntries.size() << 32;
 
-    bufferEntries.emplace_back(FileInfo(fd, library, includedFrom, sortKey));
-    return SourceBuffer{std::string_view(fd->mem.data(), fd->mem.size()), library,
-                        BufferID((uint32_t)(bufferEntries.size() - 1), fd->name)};
+    size_t index = bufferEntries.emplace_back<FileInfo>(fd, library, includedFrom, sortKey);
+    return SourceBuffer{fd->text, library, BufferID((uint32_t)index, fd->name)};
 }
 
 bool SourceManager::isCached(const fs::path& path) const {
@@ -484,21 +522,30 @@ SourceManager::BufferOrError SourceManager::openCached(const fs::path& fullPath,
         }
     }
 
-    // do the read
+    // do the read, or map the file if we've been asked to and it's possible
     SmallVector<char> buffer;
-    if (std::error_code ec = OS::readFile(absPath, buffer)) {
+    std::unique_ptr<MappedFile> mapping;
+    std::error_code ec;
+    if (memoryMapFiles)
+        ec = OS::mapFile(absPath, mapping);
+
+    if (!ec && !mapping)
+        ec = OS::readFile(absPath, buffer);
+
+    if (ec) {
         std::unique_lock lock(mutex);
         lookupCache.emplace(pathStr, std::pair{nullptr, ec});
         return nonstd::make_unexpected(ec);
     }
 
     return cacheBuffer(std::move(absPath), std::move(pathStr), includedFrom, library, sortKey,
-                       std::move(buffer));
+                       std::move(buffer), std::move(mapping));
 }
 
 SourceBuffer SourceManager::cacheBuffer(fs::path&& path, std::string&& pathStr,
                                         SourceLocation includedFrom, const SourceLibrary* library,
-                                        uint64_t sortKey, SmallVector<char>&& buffer) {
+                                        uint64_t sortKey, SmallVector<char>&& buffer,
+                                        std::unique_ptr<MappedFile>&& mapping) {
     std::string name;
     if (!disableProximatePaths) {
         std::error_code ec;
@@ -514,7 +561,7 @@ SourceBuffer SourceManager::cacheBuffer(fs::path&& path, std::string&& pathStr,
 
     auto directory = &*directories.insert(path.parent_path()).first;
     auto fd = std::make_unique<FileData>(directory, std::move(name), std::move(buffer),
-                                         std::move(path));
+                                         std::move(mapping), std::move(path));
 
     // Note: it's possible that insertion here fails due to another thread
     // racing against us to open and insert the same file. We do a lookup
@@ -528,37 +575,15 @@ SourceBuffer SourceManager::cacheBuffer(fs::path&& path, std::string&& pathStr,
     return createBufferEntry(fdPtr, includedFrom, library, sortKey, lock);
 }
 
-template<IsLock TLock>
-size_t SourceManager::getRawLineNumber(SourceLocation location, TLock& readLock) const {
-    FileData* fd;
-    {
-        // Separate scope so that info isn't used after it may potentially
-        // get invalidated when we briefly unloack a read lock and grab a
-        // write lock below.
-        const FileInfo* info = getFileInfo(location.buffer(), readLock);
-        if (!info || !info->data)
-            return 0;
-
-        fd = info->data;
-    }
-
-    if (fd->lineOffsets.empty()) {
-        // We need to compute line offsets. If the lock is a write lock then
-        // we can just go ahead and do that; if not we need to unlock the
-        // read lock and grab a write lock.
-        if constexpr (std::is_same_v<TLock, std::shared_lock<std::shared_mutex>>) {
-            readLock.unlock();
-
-            std::unique_lock writeLock(mutex);
-            computeLineOffsets(fd->mem, fd->lineOffsets);
+size_t SourceManager::getRawLineNumber(SourceLocation location) const {
+    const FileInfo* info = getFileInfo(location.buffer());
+    if (!info || !info->data)
+        return 0;
 
-            writeLock.unlock();
-            readLock.lock();
-        }
-        else {
-            computeLineOffsets(fd->mem, fd->lineOffsets);
-        }
-    }
+    // Line offsets are computed lazily the first time they're needed for
+    // a given file; once computed they never change.
+    FileData* fd = info->data;
+    std::call_once(fd->lineOffsetsFlag, [fd] { computeLineOffsets(fd->text, fd->lineOffsets); });
 
     // Find the first line offset that is greater than the given location offset. That iterator
     // then tells us how many lines away from the beginning we are.
@@ -572,19 +597,17 @@ size_t SourceManager::getRawLineNumber(SourceLocation location, TLock& readLock)
     return line;
 }
 
-template<IsLock TLock>
-SourceLocation SourceManager::getFullyExpandedLocImpl(SourceLocation location, TLock& lock) const {
-    while (isMacroLocImpl(location, lock)) {
-        if (isMacroArgLocImpl(location, lock))
-            location = getOriginalLocImpl(location, lock);
+SourceLocation SourceManager::getFullyExpandedLocImpl(SourceLocation location) const {
+    while (isMacroLocImpl(location)) {
+        if (isMacroArgLocImpl(location))
+            location = getOriginalLocImpl(location);
         else
-            location = getExpansionRangeImpl(location, lock).start();
+            location = getExpansionRangeImpl(location).start();
     }
     return location;
 }
 
-template<IsLock TLock>
-bool SourceManager::isMacroLocImpl(SourceLocation location, TLock&) const {
+bool SourceManager::isMacroLocImpl(SourceLocation location) const {
     if (location.buffer() == SourceLocation::NoLocation.buffer())
         return false;
 
@@ -596,8 +619,7 @@ bool SourceManager::isMacroLocImpl(SourceLocation location, TLock&) const {
     return std::get_if<ExpansionInfo>(&bufferEntries[buffer.getId()]) != nullptr;
 }
 
-template<IsLock TLock>
-bool SourceManager::isMacroArgLocImpl(SourceLocation location, TLock&) const {
+bool SourceManager::isMacroArgLocImpl(SourceLocation location) const {
     if (location == SourceLocation::NoLocation)
         return false;
 
@@ -610,8 +632,7 @@ bool SourceManager::isMacroArgLocImpl(SourceLocation location, TLock&) const {
     return info && info->isMacroArg;
 }
 
-template<IsLock TLock>
-SourceRange SourceManager::getExpansionRangeImpl(SourceLocation location, TLock&) const {
+SourceRange SourceManager::getExpansionRangeImpl(SourceLocation location) const {
     auto buffer = location.buffer();
     if (!buffer)
         return SourceRange();
@@ -620,8 +641,7 @@ SourceRange SourceManager::getExpansionRangeImpl(SourceLocation location, TLock&
     return std::get<ExpansionInfo>(bufferEntries[buffer.getId()]).expansionRange;
 }
 
-template<IsLock TLock>
-SourceLocation SourceManager::getOriginalLocImpl(SourceLocation location, TLock&) const {
+SourceLocation SourceManager::getOriginalLocImpl(SourceLocation location) const {
     auto buffer = location.buffer();
     if (!buffer)
         return SourceLocation();
@@ -630,7 +650,7 @@ SourceLocation SourceManager::getOriginalLocImpl(SourceLocation location, TLock&
     return std::get<ExpansionInfo>(bufferEntries[buffer.getId()]).originalLoc + location.offset();
 }
 
-void SourceManager::computeLineOffsets(const SmallVector<char>& buffer,
+void SourceManager::computeLineOffsets(std::string_view buffer,
                                        std::vector<size_t>& offsets) noexcept {
     // first line always starts at offset 0
     offsets.push_back(0);
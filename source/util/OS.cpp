@@ -24,8 +24,11 @@
 #    include <Windows.h>
 #    include <fcntl.h>
 #    include <io.h>
+#    include <psapi.h>
 #else
 #    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/resource.h>
 #    include <sys/stat.h>
 #    include <unistd.h>
 #endif
@@ -177,6 +180,90 @@ std::error_code OS::readFile(const fs::path& path, SmallVector<char>& buffer) {
     return ec;
 }
 
+MappedFile::~MappedFile() {
+    ::UnmapViewOfFile(ptr);
+}
+
+std::error_code OS::mapFile(const fs::path& path, std::unique_ptr<MappedFile>& result) {
+    result.reset();
+
+    auto& pathStr = path.native();
+    if (pathStr == L"-")
+        return {};
+
+    HANDLE handle = ::CreateFileW(pathStr.c_str(), GENERIC_READ,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) {
+        // Provide a better error when trying to open directories.
+        std::error_code ec;
+        DWORD lastErr = ::GetLastError();
+        if (lastErr == ERROR_ACCESS_DENIED && fs::is_directory(path, ec))
+            return make_error_code(std::errc::is_a_directory);
+
+        return std::error_code(lastErr, std::system_category());
+    }
+
+    std::error_code ec;
+    LARGE_INTEGER size;
+    if (::GetFileType(handle) != FILE_TYPE_DISK) {
+        // Not something we can map; let the caller read it instead.
+    }
+    else if (!::GetFileSizeEx(handle, &size)) {
+        ec.assign(::GetLastError(), std::system_category());
+    }
+    else {
+        SYSTEM_INFO sysInfo;
+        ::GetSystemInfo(&sysInfo);
+
+        // The null terminator comes from the zero-filled tail of the last page,
+        // so a file that exactly fills its last page can't be mapped.
+        auto fileSize = size_t(size.QuadPart);
+        if (fileSize != 0 && fileSize % sysInfo.dwPageSize != 0) {
+            HANDLE mapping = ::CreateFileMappingW(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping) {
+                void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (view)
+                    result.reset(new MappedFile(static_cast<const char*>(view), fileSize));
+
+                // The view keeps the mapping alive on its own.
+                ::CloseHandle(mapping);
+            }
+        }
+    }
+
+    if (!::CloseHandle(handle) && !ec)
+        ec.assign(::GetLastError(), std::system_category());
+
+    if (ec)
+        result.reset();
+
+    return ec;
+}
+
+double OS::getProcessCPUTime() {
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!::GetProcessTimes(::GetCurrentProcess(), &creationTime, &exitTime, &kernelTime,
+                           &userTime)) {
+        return 0.0;
+    }
+
+    auto toTicks = [](const FILETIME& ft) {
+        return (uint64_t(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    };
+
+    // FILETIME values are in units of 100 nanoseconds.
+    return double(toTicks(kernelTime) + toTicks(userTime)) * 1e-7;
+}
+
+size_t OS::getPeakMemoryUsage() {
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+
+    return counters.PeakWorkingSetSize;
+}
+
 #else
 
 void OS::setupConsole() {
@@ -284,6 +371,77 @@ std::error_code OS::readFile(const fs::path& path, SmallVector<char>& buffer) {
     return ec;
 }
 
+MappedFile::~MappedFile() {
+    ::munmap(const_cast<char*>(ptr), size);
+}
+
+std::error_code OS::mapFile(const fs::path& path, std::unique_ptr<MappedFile>& result) {
+    result.reset();
+
+    auto& pathStr = path.native();
+    if (pathStr == "-")
+        return {};
+
+    int fd;
+    while (true) {
+        fd = ::open(pathStr.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd >= 0)
+            break;
+
+        if (errno != EINTR)
+            return std::error_code(errno, std::generic_category());
+    }
+
+    std::error_code ec;
+    struct stat status;
+    if (::fstat(fd, &status) != 0) {
+        ec.assign(errno, std::generic_category());
+    }
+    else if (S_ISDIR(status.st_mode)) {
+        ec = make_error_code(std::errc::is_a_directory);
+    }
+    else if (S_ISREG(status.st_mode)) {
+        // The null terminator comes from the zero-filled tail of the last page,
+        // so a file that exactly fills its last page can't be mapped.
+        static const size_t pageSize = (size_t)::sysconf(_SC_PAGESIZE);
+        auto fileSize = (size_t)status.st_size;
+        if (fileSize != 0 && fileSize % pageSize != 0) {
+            void* addr = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                ::posix_madvise(addr, fileSize, POSIX_MADV_SEQUENTIAL);
+                result.reset(new MappedFile(static_cast<const char*>(addr), fileSize));
+            }
+        }
+    }
+
+    if (::close(fd) < 0 && !ec)
+        ec.assign(errno, std::generic_category());
+
+    return ec;
+}
+
+double OS::getProcessCPUTime() {
+    struct rusage usage;
+    if (::getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0.0;
+
+    auto toSeconds = [](const timeval& tv) { return double(tv.tv_sec) + tv.tv_usec * 1e-6; };
+    return toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+}
+
+size_t OS::getPeakMemoryUsage() {
+    struct rusage usage;
+    if (::getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+#    ifdef __APPLE__
+    return size_t(usage.ru_maxrss);
+#    else
+    // Linux and the BSDs report this value in kilobytes.
+    return size_t(usage.ru_maxrss) * 1024;
+#    endif
+}
+
 #endif
 
 void OS::writeFile(const fs::path& path, std::string_view contents) {
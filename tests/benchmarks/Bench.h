@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------------
+// Bench.h
+// Minimal harness for performance benchmarks
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace slang::bench {
+
+/// Gets the total number of heap allocations made by the process so far,
+/// or nullopt if allocations can't be counted in this build.
+std::optional<uint64_t> getAllocationCount();
+
+/// Collects the measurements for a single benchmark. A benchmark function
+/// sets up its inputs, fills in the amount of work done per run, and then
+/// passes the code to be measured to @a run.
+class Bench {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /// The number of bytes processed by each run of the benchmark,
+    /// used to report throughput in MB/s.
+    uint64_t bytesPerRun = 0;
+
+    /// The number of items processed by each run of the benchmark,
+    /// used to report throughput in items/s.
+    uint64_t itemsPerRun = 0;
+
+    /// The name of the items counted by @a itemsPerRun.
+    std::string_view itemName = "items";
+
+    explicit Bench(clock::duration minTime) : minTime(minTime) {}
+
+    /// Runs @a body repeatedly until at least the minimum benchmark time has passed.
+    template<typename TFunc>
+    void run(TFunc&& body) {
+        // One untimed run to warm up caches and the allocator.
+        body();
+
+        runs = 0;
+        auto startAllocs = getAllocationCount();
+        auto start = clock::now();
+        do {
+            body();
+            runs++;
+            elapsed = clock::now() - start;
+        } while (elapsed < minTime);
+        if (auto endAllocs = getAllocationCount())
+            allocs = *endAllocs - *startAllocs;
+    }
+
+    /// The number of timed runs of the benchmark body.
+    uint64_t getRuns() const { return runs; }
+
+    /// The total time spent in the timed runs.
+    clock::duration getElapsed() const { return elapsed; }
+
+    /// The total number of heap allocations made during the timed runs,
+    /// or nullopt if allocations can't be counted in this build.
+    std::optional<uint64_t> getAllocations() const { return allocs; }
+
+private:
+    clock::duration minTime;
+    clock::duration elapsed{};
+    uint64_t runs = 0;
+    std::optional<uint64_t> allocs;
+};
+
+/// Prevents the compiler from optimizing away the computation of @a value.
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const volatile void* sink;
+    sink = &value;
+#endif
+}
+
+using BenchFunc = void (*)(Bench&);
+
+struct BenchInfo {
+    std::string_view name;
+    BenchFunc func;
+};
+
+/// Gets the list of all registered benchmarks.
+std::vector<BenchInfo>& getBenchmarks();
+
+struct BenchRegistrar {
+    BenchRegistrar(std::string_view name, BenchFunc func) {
+        getBenchmarks().push_back({name, func});
+    }
+};
+
+} // namespace slang::bench
+
+/// Defines and registers a benchmark function with the given name.
+#define BENCHMARK(name)                                                        \
+    static void bench_##name(slang::bench::Bench&);                            \
+    static slang::bench::BenchRegistrar registrar_##name(#name, bench_##name); \
+    static void bench_##name(slang::bench::Bench& bench)
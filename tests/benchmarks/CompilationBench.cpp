@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+
+#include "Bench.h"
+#include <fmt/format.h>
+
+#include "slang/ast/ASTVisitor.h"
+#include "slang/ast/Compilation.h"
+#include "slang/syntax/SyntaxTree.h"
+
+using namespace slang;
+using namespace slang::ast;
+using namespace slang::bench;
+using namespace slang::syntax;
+
+namespace {
+
+struct SymbolCounter : public ASTVisitor<SymbolCounter, false, false> {
+    size_t count = 0;
+
+    template<typename T>
+        requires std::is_base_of_v<Symbol, T>
+    void handle(const T& symbol) {
+        count++;
+        visitDefault(symbol);
+    }
+};
+
+} // namespace
+
+static size_t compileAll(const std::shared_ptr<SyntaxTree>& tree, size_t* symbolCount = nullptr) {
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    size_t numDiags = compilation.getAllDiagnostics().size();
+
+    if (symbolCount) {
+        SymbolCounter counter;
+        compilation.getRoot().visit(counter);
+        *symbolCount = counter.count;
+    }
+    return numDiags;
+}
+
+// Parses the given design once and then measures full elaboration and
+// analysis of it, reporting throughput in terms of both source bytes
+// and the number of symbols in the elaborated hierarchy.
+static void benchCompilation(Bench& bench, const std::string& text) {
+    auto tree = SyntaxTree::fromText(text);
+
+    size_t symbolCount = 0;
+    if (auto numDiags = compileAll(tree, &symbolCount)) {
+        throw std::runtime_error(
+            fmt::format("benchmark design has {} unexpected diagnostics", numDiags));
+    }
+
+    bench.bytesPerRun = text.size();
+    bench.itemsPerRun = symbolCount;
+    bench.itemName = "sym";
+    bench.run([&] { doNotOptimize(compileAll(tree)); });
+}
+
+BENCHMARK(compilation_deep_hierarchy) {
+    // A binary tree of instances, with a distinct module for each level
+    // and a bit of logic at every level so the bodies aren't empty.
+    constexpr int Depth = 10;
+
+    std::string text;
+    for (int level = 0; level < Depth; level++) {
+        fmt::format_to(std::back_inserter(text),
+                       "module level{0}(input logic clk, input logic [7:0] in, "
+                       "output logic [7:0] out);\n"
+                       "    logic [7:0] l, r;\n",
+                       level);
+        if (level == Depth - 1) {
+            text += "    always_ff @(posedge clk) out <= in + 8'd1;\n";
+        }
+        else {
+            fmt::format_to(std::back_inserter(text),
+                           "    level{0} left(.clk, .in(in), .out(l));\n"
+                           "    level{0} right(.clk, .in(in ^ 8'hFF), .out(r));\n"
+                           "    assign out = l + r;\n",
+                           level + 1);
+        }
+        text += "endmodule\n\n";
+    }
+
+    benchCompilation(bench, text);
+}
+
+BENCHMARK(compilation_huge_arrays) {
+    // Large arrays of instances and large unpacked arrays with initializers.
+    constexpr int NumInstances = 4096;
+    constexpr int NumArrays = 64;
+
+    std::string text = "module leaf(input logic [7:0] a, output logic [7:0] b);\n"
+                       "    assign b = ~a;\n"
+                       "endmodule\n\n";
+
+    fmt::format_to(std::back_inserter(text),
+                   "module top;\n"
+                   "    logic [7:0] x[{0}], y[{0}];\n"
+                   "    leaf u[{0}](.a(x), .b(y));\n",
+                   NumInstances);
+
+    for (int i = 0; i < NumArrays; i++) {
+        fmt::format_to(std::back_inserter(text),
+                       "    localparam int table{0}[1024] = '{{default: {0}}};\n"
+                       "    int mem{0}[1024];\n"
+                       "    always_comb\n"
+                       "        for (int i = 0; i < 1024; i++) mem{0}[i] = table{0}[i] + i;\n",
+                       i);
+    }
+
+    text += "endmodule\n";
+    benchCompilation(bench, text);
+}
+
+BENCHMARK(compilation_wide_package) {
+    // A package with many parameters, types and functions, used from a module.
+    constexpr int NumMembers = 4000;
+
+    std::string text = "package pkg;\n";
+    for (int i = 0; i < NumMembers; i++) {
+        fmt::format_to(std::back_inserter(text),
+                       "    localparam int P{0} = {0} * 3 + 1;\n"
+                       "    typedef struct packed {{ logic [P{0} % 32:0] a; logic b; }} s{0}_t;\n"
+                       "    function automatic int f{0}(int x); return x + P{0}; endfunction\n",
+                       i);
+    }
+    text += "endpackage\n\nmodule top;\n    import pkg::*;\n";
+
+    for (int i = 0; i < NumMembers; i += 4) {
+        fmt::format_to(std::back_inserter(text),
+                       "    s{0}_t v{0};\n"
+                       "    localparam int q{0} = f{0}(P{0});\n",
+                       i);
+    }
+    text += "endmodule\n";
+
+    benchCompilation(bench, text);
+}
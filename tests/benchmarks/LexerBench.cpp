@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+
+#include "Bench.h"
+#include <fmt/format.h>
+
+#include "slang/diagnostics/Diagnostics.h"
+#include "slang/parsing/Lexer.h"
+#include "slang/text/SourceManager.h"
+#include "slang/util/BumpAllocator.h"
+
+using namespace slang;
+using namespace slang::bench;
+using namespace slang::parsing;
+
+// Each generated input is roughly this many bytes.
+static constexpr size_t TargetSize = 4 * 1024 * 1024;
+
+static size_t lexAll(const SourceBuffer& buffer) {
+    BumpAllocator alloc;
+    Diagnostics diagnostics;
+    Lexer lexer(buffer, alloc, diagnostics);
+
+    size_t count = 0;
+    while (lexer.lex().kind != TokenKind::EndOfFile)
+        count++;
+    return count;
+}
+
+template<typename TFunc>
+static void benchLexer(Bench& bench, TFunc&& generate) {
+    std::string text;
+    for (size_t i = 0; text.size() < TargetSize; i++)
+        generate(text, i);
+
+    SourceManager sourceManager;
+    auto buffer = sourceManager.assignText(text);
+
+    bench.bytesPerRun = text.size();
+    bench.itemsPerRun = lexAll(buffer);
+    bench.itemName = "tok";
+    bench.run([&] { doNotOptimize(lexAll(buffer)); });
+}
+
+BENCHMARK(lexer_netlist) {
+    // Gate-level netlists are dominated by long hierarchical names and indentation.
+    benchLexer(bench, [](std::string& text, size_t i) {
+        fmt::format_to(std::back_inserter(text),
+                       "    DFFRX1_LVT u_core_datapath_stage{}_pipeline_reg_{}_ (\n"
+                       "        .CK(core_clk_gated_domain_{}), .RN(sync_reset_n_stage_{}),\n"
+                       "        .D(u_core_datapath_stage{}_next_value_bus_{}_),\n"
+                       "        .Q(u_core_datapath_stage{}_current_value_bus_{}_));\n",
+                       i % 17, i, i % 5, i % 3, i % 17, i, i % 17, i);
+    });
+}
+
+BENCHMARK(lexer_comments) {
+    benchLexer(bench, [](std::string& text, size_t i) {
+        fmt::format_to(std::back_inserter(text),
+                       "    // This register holds the value of stage {} of the datapath pipeline\n"
+                       "    /* Generated by the netlist writer; do not edit. The original RTL\n"
+                       "       signal was core.datapath.stage[{}].value and was retimed. */\n"
+                       "    wire w{};\n",
+                       i % 17, i % 17, i);
+    });
+}
+
+BENCHMARK(lexer_strings) {
+    benchLexer(bench, [](std::string& text, size_t i) {
+        fmt::format_to(std::back_inserter(text),
+                       "    initial $display(\"%t: transaction {} completed with status %0d and "
+                       "payload %h\", $time, status, payload);\n"
+                       "    string s{} = \"a moderately long string literal\\twith an escape\";\n",
+                       i, i);
+    });
+}
+
+BENCHMARK(lexer_rtl) {
+    benchLexer(bench, [](std::string& text, size_t i) {
+        fmt::format_to(std::back_inserter(text),
+                       "always_ff @(posedge clk or negedge rst_n) begin\n"
+                       "    if (!rst_n) count_{} <= '0;\n"
+                       "    else if (enable && count_{} != 32'hFFFF_{:04X})\n"
+                       "        count_{} <= count_{} + 1; // increment\n"
+                       "end\n",
+                       i, i, i % 0x10000, i, i);
+    });
+}
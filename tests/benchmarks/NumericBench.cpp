@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+
+#include "Bench.h"
+
+#include "slang/numeric/SVInt.h"
+
+using namespace slang;
+using namespace slang::bench;
+
+// Number of operations performed in each run of a benchmark.
+static constexpr size_t NumOps = 1000;
+
+// Makes a list of pseudo-random values of the given width.
+static std::vector<SVInt> makeValues(bitwidth_t width, size_t count, bool isSigned = false) {
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    std::vector<SVInt> values;
+    std::vector<byte> bytes((width + 7) / 8);
+    for (size_t i = 0; i < count; i++) {
+        for (auto& b : bytes) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            b = byte(state >> 56);
+        }
+        values.emplace_back(width, bytes, isSigned);
+    }
+    return values;
+}
+
+// Makes a list of pseudo-random values of the given width with their low bits set to X.
+static std::vector<SVInt> makeUnknownValues(bitwidth_t width, size_t count) {
+    auto values = makeValues(width, count);
+    for (auto& value : values)
+        value.set(3, 0, SVInt::createFillX(4, false));
+    return values;
+}
+
+template<typename TFunc>
+static void benchBinaryOp(Bench& bench, bitwidth_t width, TFunc&& op, bool unknown = false) {
+    auto lhs = unknown ? makeUnknownValues(width, NumOps) : makeValues(width, NumOps);
+    auto rhs = makeValues(width, NumOps + 1);
+    rhs.erase(rhs.begin());
+
+    bench.itemsPerRun = NumOps;
+    bench.itemName = "op";
+    bench.run([&] {
+        for (size_t i = 0; i < NumOps; i++)
+            doNotOptimize(op(lhs[i], rhs[i]));
+    });
+}
+
+BENCHMARK(svint_add_64) {
+    benchBinaryOp(bench, 64, [](const SVInt& a, const SVInt& b) { return a + b; });
+}
+
+BENCHMARK(svint_add_128) {
+    benchBinaryOp(bench, 128, [](const SVInt& a, const SVInt& b) { return a + b; });
+}
+
+BENCHMARK(svint_add_1024) {
+    benchBinaryOp(bench, 1024, [](const SVInt& a, const SVInt& b) { return a + b; });
+}
+
+BENCHMARK(svint_mul_64) {
+    benchBinaryOp(bench, 64, [](const SVInt& a, const SVInt& b) { return a * b; });
+}
+
+BENCHMARK(svint_mul_128) {
+    benchBinaryOp(bench, 128, [](const SVInt& a, const SVInt& b) { return a * b; });
+}
+
+BENCHMARK(svint_mul_1024) {
+    benchBinaryOp(bench, 1024, [](const SVInt& a, const SVInt& b) { return a * b; });
+}
+
+BENCHMARK(svint_div_1024) {
+    benchBinaryOp(bench, 1024, [](const SVInt& a, const SVInt& b) {
+        // Divide by a smaller value so the quotient isn't trivially zero.
+        return a / b.lshr(512);
+    });
+}
+
+BENCHMARK(svint_shift_1024) {
+    benchBinaryOp(bench, 1024, [](const SVInt& a, const SVInt& b) {
+        return a.shl(bitwidth_t(b.getRawPtr()[0] % 1024));
+    });
+}
+
+BENCHMARK(svint_compare_1024) {
+    benchBinaryOp(bench, 1024, [](const SVInt& a, const SVInt& b) { return a < b; });
+}
+
+BENCHMARK(svint_and_4state_64) {
+    benchBinaryOp(
+        bench, 64, [](const SVInt& a, const SVInt& b) { return a & b; }, /* unknown */ true);
+}
+
+BENCHMARK(svint_add_4state_64) {
+    benchBinaryOp(
+        bench, 64, [](const SVInt& a, const SVInt& b) { return a + b; }, /* unknown */ true);
+}
+
+static void benchToDecimal(Bench& bench, bitwidth_t width, size_t count) {
+    auto values = makeValues(width, count);
+
+    bench.itemsPerRun = values.size();
+    bench.itemName = "op";
+    bench.run([&] {
+        for (auto& value : values)
+            doNotOptimize(value.toString(LiteralBase::Decimal, false));
+    });
+}
+
+static void benchFromDecimal(Bench& bench, bitwidth_t width, size_t count) {
+    std::vector<std::string> strings;
+    for (auto& value : makeValues(width, count))
+        strings.push_back(value.toString(LiteralBase::Decimal, true));
+
+    bench.itemsPerRun = strings.size();
+    bench.itemName = "op";
+    bench.run([&] {
+        for (auto& str : strings)
+            doNotOptimize(SVInt::fromString(str));
+    });
+}
+
+BENCHMARK(svint_to_decimal_4096) {
+    benchToDecimal(bench, 4096, 16);
+}
+
+BENCHMARK(svint_to_decimal_65536) {
+    benchToDecimal(bench, 65536, 1);
+}
+
+BENCHMARK(svint_from_decimal_4096) {
+    benchFromDecimal(bench, 4096, 16);
+}
+
+BENCHMARK(svint_from_decimal_65536) {
+    benchFromDecimal(bench, 65536, 1);
+}
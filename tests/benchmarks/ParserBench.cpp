@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+
+#include "Bench.h"
+#include <fmt/format.h>
+
+#include "slang/syntax/SyntaxTree.h"
+#include "slang/text/SourceManager.h"
+
+using namespace slang;
+using namespace slang::bench;
+using namespace slang::syntax;
+
+// Each generated input is roughly this many bytes.
+static constexpr size_t TargetSize = 2 * 1024 * 1024;
+
+template<typename TFunc>
+static void benchParser(Bench& bench, TFunc&& generate) {
+    std::string text;
+    for (size_t i = 0; text.size() < TargetSize; i++)
+        generate(text, i);
+
+    SourceManager sourceManager;
+    auto buffer = sourceManager.assignText(text);
+
+    bench.bytesPerRun = text.size();
+    bench.run([&] { doNotOptimize(SyntaxTree::fromBuffer(buffer, sourceManager)); });
+}
+
+BENCHMARK(parser_rtl) {
+    benchParser(bench, [](std::string& text, size_t i) {
+        fmt::format_to(std::back_inserter(text),
+                       "module counter_{} #(parameter int W = {}) (\n"
+                       "    input logic clk, rst_n, en,\n"
+                       "    output logic [W-1:0] count\n"
+                       ");\n"
+                       "    always_ff @(posedge clk or negedge rst_n) begin\n"
+                       "        if (!rst_n) count <= '0;\n"
+                       "        else if (en && count != {{W{{1'b1}}}}) count <= count + 1'b1;\n"
+                       "    end\n"
+                       "endmodule\n\n",
+                       i, i % 32 + 1);
+    });
+}
+
+BENCHMARK(parser_expressions) {
+    benchParser(bench, [](std::string& text, size_t i) {
+        if (i == 0)
+            text += "module m;\n";
+        fmt::format_to(std::back_inserter(text),
+                       "    assign y[{}] = ((a[{}] + b * {}) << 2) ^ (c ? d[{}:0] : ~e) | "
+                       "f.g[h].i == {{j, k, 4'b10x1}};\n",
+                       i % 256, i % 64, i, i % 31);
+        if (text.size() >= TargetSize)
+            text += "endmodule\n";
+    });
+}
+
+BENCHMARK(parser_netlist) {
+    benchParser(bench, [](std::string& text, size_t i) {
+        if (i == 0)
+            text += "module top(input clk, input rst_n);\n";
+        fmt::format_to(std::back_inserter(text),
+                       "    DFFRX1 u_reg_{} (.CK(clk), .RN(rst_n), .D(n_{}), .Q(q_{}));\n"
+                       "    NAND2X1 u_nand_{} (.A(q_{}), .B(q_{}), .Y(n_{}));\n",
+                       i, i, i, i, i, i / 2, i + 1);
+        if (text.size() >= TargetSize)
+            text += "endmodule\n";
+    });
+}
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+
+#include "Bench.h"
+#include <fmt/format.h>
+
+#include "slang/diagnostics/Diagnostics.h"
+#include "slang/parsing/Preprocessor.h"
+#include "slang/text/SourceManager.h"
+#include "slang/util/BumpAllocator.h"
+
+using namespace slang;
+using namespace slang::bench;
+using namespace slang::parsing;
+
+// Each generated input is roughly this many bytes.
+static constexpr size_t TargetSize = 2 * 1024 * 1024;
+
+static size_t preprocessAll(SourceManager& sourceManager, const SourceBuffer& buffer) {
+    BumpAllocator alloc;
+    Diagnostics diagnostics;
+    Preprocessor preprocessor(sourceManager, alloc, diagnostics);
+    preprocessor.pushSource(buffer);
+
+    size_t count = 0;
+    while (preprocessor.next().kind != TokenKind::EndOfFile)
+        count++;
+    return count;
+}
+
+template<typename TFunc>
+static void benchPreprocessor(Bench& bench, std::string_view prelude, TFunc&& generate) {
+    std::string text(prelude);
+    for (size_t i = 0; text.size() < TargetSize; i++)
+        generate(text, i);
+
+    SourceManager sourceManager;
+    auto buffer = sourceManager.assignText(text);
+
+    bench.bytesPerRun = text.size();
+    bench.itemsPerRun = preprocessAll(sourceManager, buffer);
+    bench.itemName = "tok";
+    bench.run([&] { doNotOptimize(preprocessAll(sourceManager, buffer)); });
+}
+
+BENCHMARK(preprocessor_no_macros) {
+    // Plain code with no directives, to measure the overhead on top of the lexer.
+    benchPreprocessor(bench, "", [](std::string& text, size_t i) {
+        fmt::format_to(std::back_inserter(text),
+                       "assign out_{} = (in_a_{} & mask[{}]) | (in_b_{} ^ 8'h{:02X});\n", i, i,
+                       i % 64, i, i % 256);
+    });
+}
+
+BENCHMARK(preprocessor_object_macros) {
+    benchPreprocessor(bench,
+                      "`define WIDTH 32\n"
+                      "`define RESET_VALUE {`WIDTH{1'b0}}\n"
+                      "`define ADDR_BITS 12\n",
+                      [](std::string& text, size_t i) {
+                          fmt::format_to(std::back_inserter(text),
+                                         "logic [`WIDTH-1:0] reg_{} = `RESET_VALUE;\n"
+                                         "logic [`ADDR_BITS-1:0] addr_{};\n",
+                                         i, i);
+                      });
+}
+
+BENCHMARK(preprocessor_function_macros) {
+    // Nested function-like macros with token pasting and stringification,
+    // in the style of UVM field and register macros.
+    benchPreprocessor(bench,
+                      "`define REG_NAME(blk, idx) blk``_reg_``idx\n"
+                      "`define FIELD(blk, idx, w) logic [w-1:0] `REG_NAME(blk, idx);\n"
+                      "`define CHECK(cond, msg) if (!(cond)) $error(`\"msg: cond`\");\n",
+                      [](std::string& text, size_t i) {
+                          fmt::format_to(std::back_inserter(text),
+                                         "`FIELD(ctrl, {}, {})\n"
+                                         "`CHECK(`REG_NAME(ctrl, {}) != 0, bad value)\n",
+                                         i, i % 64 + 1, i);
+                      });
+}
+
+BENCHMARK(preprocessor_conditionals) {
+    benchPreprocessor(bench, "`define FEATURE_A\n", [](std::string& text, size_t i) {
+        fmt::format_to(std::back_inserter(text),
+                       "`ifdef FEATURE_A\n"
+                       "  wire a_{};\n"
+                       "`elsif FEATURE_B\n"
+                       "  wire b_{};\n"
+                       "`else\n"
+                       "  wire c_{};\n"
+                       "`endif\n",
+                       i, i, i);
+    });
+}
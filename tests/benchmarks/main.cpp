@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+
+#include "Bench.h"
+#include <atomic>
+#include <cstdlib>
+#include <fmt/core.h>
+#include <new>
+
+#include "slang/text/Json.h"
+#include "slang/util/CommandLine.h"
+#include "slang/util/OS.h"
+
+using namespace slang;
+using namespace slang::bench;
+
+#if defined(SLANG_USE_MIMALLOC)
+
+// The library already replaces the global allocation functions with mimalloc's,
+// so they can't be hooked here, and mimalloc doesn't count allocations in
+// release builds.
+std::optional<uint64_t> slang::bench::getAllocationCount() {
+    return std::nullopt;
+}
+
+#else
+
+static std::atomic<uint64_t> allocationCount;
+
+// Count every heap allocation so that benchmarks can report allocations per run.
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+std::optional<uint64_t> slang::bench::getAllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+#endif
+
+std::vector<BenchInfo>& slang::bench::getBenchmarks() {
+    static std::vector<BenchInfo> benchmarks;
+    return benchmarks;
+}
+
+static std::string formatRate(double perSecond, std::string_view unit) {
+    if (perSecond >= 1e9)
+        return fmt::format("{:.2f} G{}/s", perSecond / 1e9, unit);
+    if (perSecond >= 1e6)
+        return fmt::format("{:.2f} M{}/s", perSecond / 1e6, unit);
+    if (perSecond >= 1e3)
+        return fmt::format("{:.2f} k{}/s", perSecond / 1e3, unit);
+    return fmt::format("{:.2f} {}/s", perSecond, unit);
+}
+
+int main(int argc, char** argv) {
+    OS::setupConsole();
+
+    CommandLine cmdLine;
+    std::optional<bool> showHelp;
+    std::optional<bool> listOnly;
+    std::optional<double> minTime;
+    std::optional<std::string> jsonFile;
+    std::vector<std::string> filters;
+    cmdLine.add("-h,--help", showHelp, "Display available options");
+    cmdLine.add("--list", listOnly, "List the names of all benchmarks and exit");
+    cmdLine.add("--min-time", minTime,
+                "The minimum number of seconds to spend running each benchmark", "<seconds>");
+    cmdLine.add("--json", jsonFile,
+                "Also write the results in JSON format to the specified file, or '-' for stdout",
+                "<file>", CommandLineFlags::FilePath);
+    cmdLine.setPositional(filters, "filters");
+
+    if (!cmdLine.parse(argc, argv)) {
+        for (auto& err : cmdLine.getErrors())
+            OS::printE(fmt::format("{}\n", err));
+        return 1;
+    }
+
+    if (showHelp == true) {
+        OS::print(fmt::format("{}\n", cmdLine.getHelpText("slang performance benchmarks")));
+        return 0;
+    }
+
+    auto matches = [&](std::string_view name) {
+        if (filters.empty())
+            return true;
+
+        for (auto& filter : filters) {
+            if (name.find(filter) != std::string_view::npos)
+                return true;
+        }
+        return false;
+    };
+
+    auto duration = std::chrono::duration_cast<Bench::clock::duration>(
+        std::chrono::duration<double>(minTime.value_or(1.0)));
+
+    JsonWriter writer;
+    writer.setPrettyPrint(true);
+    writer.startArray();
+
+    for (auto& info : getBenchmarks()) {
+        if (!matches(info.name))
+            continue;
+
+        if (listOnly == true) {
+            OS::print(fmt::format("{}\n", info.name));
+            continue;
+        }
+
+        Bench bench(duration);
+        info.func(bench);
+
+        double seconds = std::chrono::duration<double>(bench.getElapsed()).count();
+        double runs = double(bench.getRuns());
+        std::string line = fmt::format("{:<40} {:>10} runs {:>14.0f} ns/run", info.name,
+                                       bench.getRuns(), seconds * 1e9 / runs);
+        if (bench.bytesPerRun) {
+            auto rate = double(bench.bytesPerRun) * runs / seconds;
+            line += fmt::format("  {:>14}", formatRate(rate, "B"));
+        }
+        if (bench.itemsPerRun) {
+            auto rate = double(bench.itemsPerRun) * runs / seconds;
+            line += fmt::format("  {:>20}", formatRate(rate, bench.itemName));
+        }
+        if (auto allocs = bench.getAllocations())
+            line += fmt::format("  {:>10.1f} allocs/run", double(*allocs) / runs);
+
+        // Don't mix the human readable output in with the JSON output.
+        if (jsonFile != "-")
+            OS::print(line + "\n");
+
+        writer.startObject();
+        writer.writeProperty("name");
+        writer.writeValue(info.name);
+        writer.writeProperty("runs");
+        writer.writeValue(bench.getRuns());
+        writer.writeProperty("nsPerRun");
+        writer.writeValue(seconds * 1e9 / runs);
+        if (auto allocs = bench.getAllocations()) {
+            writer.writeProperty("allocsPerRun");
+            writer.writeValue(double(*allocs) / runs);
+        }
+        if (bench.bytesPerRun) {
+            writer.writeProperty("bytesPerSecond");
+            writer.writeValue(double(bench.bytesPerRun) * runs / seconds);
+        }
+        if (bench.itemsPerRun) {
+            writer.writeProperty("itemsPerSecond");
+            writer.writeValue(double(bench.itemsPerRun) * runs / seconds);
+            writer.writeProperty("itemName");
+            writer.writeValue(bench.itemName);
+        }
+        writer.endObject();
+    }
+
+    writer.endArray();
+    if (jsonFile && listOnly != true) {
+        writer.writeNewLine();
+        OS::writeFile(*jsonFile, writer.view());
+    }
+
+    return 0;
+}
@@ -271,6 +271,65 @@ TEST_CASE("Driver parsing with library modules") {
     CHECK(stderrContains("foobaz"));
 }
 
+TEST_CASE("Driver library search directories") {
+    auto guard = OS::captureOutput();
+
+    Driver driver;
+    driver.addStandardArgs();
+
+    // Each wave of searches finds several files, which in turn instantiate
+    // the modules found by the next wave. Files are taken from the first
+    // directory that has them, and nothing else is loaded.
+    auto args = fmt::format("testfoo \"{0}libsearch/top.sv\" -y \"{0}libsearch/lib0\" "
+                            "-y \"{0}libsearch/lib1\" -y \"{0}libsearch/lib2\" -j 4",
+                            findTestDir());
+    CHECK(driver.parseCommandLine(args));
+    CHECK(driver.processOptions());
+    CHECK(driver.parseAllSources());
+    CHECK(driver.syntaxTrees.size() == 9);
+
+    auto compilation = driver.createCompilation();
+    CHECK(driver.reportCompilation(*compilation, false));
+    CHECK(stdoutContains("Build succeeded"));
+}
+
+TEST_CASE("Driver library search in parallel matches serial") {
+    // Each wave of searches here finds well over MinFilesForThreading files,
+    // all of which have diagnostics, so parsing them on several threads must
+    // give the same trees and report the same diagnostics in the same order
+    // as parsing them on one.
+    auto load = [](std::string_view threads) {
+        auto guard = OS::captureOutput();
+
+        Driver driver;
+        driver.addStandardArgs();
+
+        auto args = fmt::format("testfoo \"{0}libthreads/top.sv\" -y \"{0}libthreads\" -j {1}",
+                                findTestDir(), threads);
+        CHECK(driver.parseCommandLine(args));
+        CHECK(driver.processOptions());
+        CHECK(driver.parseAllSources());
+        CHECK(driver.syntaxTrees.size() == 21);
+
+        std::vector<std::string> names;
+        for (auto& tree : driver.syntaxTrees) {
+            auto buffer = tree->root().sourceRange().start().buffer();
+            names.emplace_back(driver.sourceManager.getRawFileName(buffer));
+        }
+
+        auto compilation = driver.createCompilation();
+        CHECK(!driver.reportCompilation(*compilation, false));
+        return std::pair{names, OS::capturedStderr};
+    };
+
+    auto [serialNames, serialDiags] = load("1");
+    auto [parallelNames, parallelDiags] = load("4");
+    CHECK(parallelNames == serialNames);
+    CHECK(parallelDiags == serialDiags);
+    CHECK(serialDiags.find("undeclared8") != std::string::npos);
+    CHECK(serialDiags.find("other9") != std::string::npos);
+}
+
 TEST_CASE("Driver invalid library module file") {
     auto guard = OS::captureOutput();
 
@@ -314,6 +373,45 @@ TEST_CASE("Driver full compilation") {
     CHECK(stdoutContains("Build succeeded"));
 }
 
+TEST_CASE("Driver compilation stats") {
+    auto guard = OS::captureOutput();
+
+    Driver driver;
+    driver.addStandardArgs();
+
+    auto args = fmt::format("testfoo \"{0}test.sv\" --stats", findTestDir());
+    CHECK(driver.parseCommandLine(args));
+    CHECK(driver.processOptions());
+    CHECK(driver.options.showStats == true);
+
+    bool ok = false;
+    driver.measurePhase("parse", [&] { ok = driver.parseAllSources(); });
+    CHECK(ok);
+
+    std::unique_ptr<Compilation> compilation;
+    driver.measurePhase("elaborate", [&] {
+        compilation = driver.createCompilation();
+        compilation->getRoot();
+    });
+
+    OS::capturedStdout.clear();
+    driver.reportStats(compilation.get());
+
+    auto& output = OS::capturedStdout;
+    CHECK(output.find("\nparse ") != std::string::npos);
+    CHECK(output.find("\nelaborate ") != std::string::npos);
+    CHECK(output.find("\ntotal ") != std::string::npos);
+    CHECK(stdoutContains("Tokens:"));
+    CHECK(stdoutContains("Syntax nodes:"));
+    CHECK(stdoutContains("Symbols:"));
+
+    // Without a compilation only the syntax is counted.
+    OS::capturedStdout.clear();
+    driver.reportStats();
+    CHECK(stdoutContains("Tokens:"));
+    CHECK(!stdoutContains("Symbols:"));
+}
+
 TEST_CASE("Driver full compilation with defines and param overrides") {
     auto guard = OS::captureOutput();
 
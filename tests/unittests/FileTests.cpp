@@ -6,7 +6,9 @@
 
 #include "slang/text/Glob.h"
 #include "slang/text/SourceManager.h"
+#include "slang/util/OS.h"
 #include "slang/util/String.h"
+#include "slang/util/ThreadPool.h"
 
 std::string getTestInclude() {
     return findTestDir() + "/include.svh";
@@ -23,6 +25,67 @@ TEST_CASE("Read source") {
     CHECK(file->data.length() > 0);
 }
 
+TEST_CASE("Read source (memory mapped)") {
+    SourceManager manager;
+    manager.setMemoryMapFiles(true);
+    std::string testPath = getTestInclude();
+
+    auto result = manager.readSource("X:\\nonsense.txt", /* library */ nullptr);
+    CHECK(!result);
+    CHECK(result.error() == std::errc::no_such_file_or_directory);
+
+    auto file = manager.readSource(testPath, /* library */ nullptr);
+    REQUIRE(file);
+    REQUIRE(file->data.length() > 0);
+    CHECK(file->data.back() == '\0');
+
+    SmallVector<char> expected;
+    REQUIRE(!OS::readFile(testPath, expected));
+    CHECK(file->data == std::string_view(expected.data(), expected.size()));
+    CHECK(manager.getSourceText(file->id) == file->data);
+    CHECK(manager.getLineNumber(SourceLocation(file->id, file->data.length() - 1)) > 1);
+}
+
+TEST_CASE("Concurrent location queries") {
+    SourceManager manager;
+    auto buffer = manager.assignText("module m;\n  int i;\nendmodule\n");
+    SourceLocation fileLoc(buffer.id, 12);
+
+    // Enough expansions to span several of the internal storage chunks.
+    constexpr size_t NumExpansions = 5000;
+    std::vector<SourceLocation> expansions;
+    for (size_t i = 0; i < NumExpansions; i++) {
+        auto prev = expansions.empty() ? fileLoc : expansions.back();
+        expansions.push_back(manager.createExpansionLoc(prev, SourceRange(prev, prev + 1), false));
+    }
+
+    // Query existing locations while other threads keep adding new buffers.
+    std::atomic<size_t> failures = 0;
+    ThreadPool pool(4);
+    for (size_t t = 0; t < 4; t++) {
+        pool.pushTask([&, t] {
+            for (size_t i = t; i < NumExpansions; i += 4) {
+                if (t % 2 == 0) {
+                    manager.createExpansionLoc(fileLoc, SourceRange(fileLoc, fileLoc + 1), true);
+                    manager.assignText(std::to_string(i));
+                }
+
+                auto loc = expansions[i];
+                if (!manager.isMacroLoc(loc) ||
+                    manager.getOriginalLoc(loc) != (i ? expansions[i - 1] : fileLoc) ||
+                    manager.getFullyOriginalLoc(loc) != fileLoc ||
+                    manager.getLineNumber(loc) != 2 || manager.getColumnNumber(fileLoc) != 3) {
+                    failures++;
+                }
+            }
+        });
+    }
+    pool.waitForAll();
+
+    CHECK(failures == 0);
+    CHECK(manager.getAllBuffers().size() == NumExpansions * 2 + 1);
+}
+
 TEST_CASE("Read header (absolute)") {
     SourceManager manager;
     std::string testPath = getTestInclude();
@@ -156,7 +219,8 @@ TEST_CASE("Directory globbing") {
     globAndCheck(testDir, "system", GlobMode::Directories, GlobRank::ExactPath, {}, {"system"});
     globAndCheck(testDir, "system/", GlobMode::Directories, GlobRank::ExactPath, {}, {"system"});
     globAndCheck(testDir, ".../", GlobMode::Directories, GlobRank::Directory, {},
-                 {"library", "nested", "system", "data", "libtest"});
+                 {"library", "nested", "system", "data", "libtest", "libsearch", "libthreads",
+                  "lib0", "lib1", "lib2"});
     globAndCheck(testDir, testDir + "/library/pkg.sv", GlobMode::Directories, GlobRank::ExactPath,
                  make_error_code(std::errc::not_a_directory), {});
 }
@@ -505,6 +505,140 @@ TEST_CASE("Unpacked array eval") {
     NO_SESSION_ERRORS;
 }
 
+TEST_CASE("Unpacked array reads in functions") {
+    ScriptSession session;
+    session.eval(R"(
+function automatic integer lut(int i);
+    integer table_[7:2];
+    foreach (table_[j])
+        table_[j] = j * j;
+    return table_[i];
+endfunction
+)");
+
+    CHECK(session.eval("lut(2)").integer() == 4);
+    CHECK(session.eval("lut(7)").integer() == 49);
+    CHECK(session.eval("lut(3) + lut(4)").integer() == 25);
+    NO_SESSION_ERRORS;
+
+    // Out of bounds reads produce the default value.
+    auto cv = session.eval("lut(8)");
+    CHECK(cv.integer().hasUnknown());
+
+    auto diags = session.getDiagnostics();
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::IndexOOB);
+}
+
+TEST_CASE("Constant function building a large CRC table") {
+    // This takes more steps than the old default limit of 100000.
+    ScriptSession session;
+    session.eval(R"(
+function automatic logic [31:0] crcEntry(int index);
+    logic [31:0] table_[4096];
+    for (int i = 0; i < 4096; i++) begin
+        logic [31:0] crc = i;
+        for (int j = 0; j < 8; j++) begin
+            if (crc[0])
+                crc = (crc >> 1) ^ 32'hEDB88320;
+            else
+                crc = crc >> 1;
+        end
+        table_[i] = crc;
+    end
+    return table_[index];
+endfunction
+)");
+
+    CHECK(session.eval("crcEntry(1)").integer() == 0x77073096);
+    CHECK(session.eval("crcEntry(255)").integer() == 0x2D02EF8D);
+    NO_SESSION_ERRORS;
+}
+
+TEST_CASE("Large unpacked arrays in functions") {
+    ScriptSession session;
+    session.eval(R"(
+function automatic logic [11:0] fill(int i);
+    logic [11:0] mem [0:1023];
+    logic [11:0] copy [0:1023];
+    logic [11:0] part [0:1];
+    if (!$isunknown(mem[i]))
+        return '1;
+
+    foreach (mem[j])
+        mem[j] = 12'(unsigned'(j * 3));
+    mem[10] += 5;
+    mem[11][3:0] = 4'hf;
+    mem[12] = 'x;
+    mem[20:22] = '{1, 2, 3};
+    copy = mem;
+    part = mem[21:22];
+    copy[0] = part[0] + part[1] + 12'd72;
+    return copy[i];
+endfunction
+)");
+
+    session.eval(R"(
+function automatic int sum(int n);
+    int vals [512];
+    int total = 0;
+    for (int i = 0; i < 512; i++)
+        vals[i] = 511 - i;
+    for (int i = 0; i < n; i++)
+        total += vals[i];
+    return total;
+endfunction
+)");
+
+    session.eval(R"(
+typedef bit [99:0] wide_t [300];
+function automatic wide_t wide();
+    wide[0] = 100'(1) << 99;
+    wide[299][99:98] = 2'b11;
+endfunction
+)");
+
+    session.eval("localparam wide_t W = wide();");
+
+    CHECK(session.eval("fill(5)").integer() == 15);
+    CHECK(session.eval("fill(10)").integer() == 35);
+    CHECK(session.eval("fill(11)").integer() == 47);
+    CHECK(session.eval("fill(12)").integer().hasUnknown());
+    CHECK(session.eval("fill(21)").integer() == 2);
+    CHECK(session.eval("fill(0)").integer() == 77);
+    CHECK(session.eval("fill(1023)").integer() == (1023 * 3) % 4096);
+    CHECK(session.eval("sum(4)").integer() == 2038);
+    CHECK(session.eval("W[0] == 100'(1) << 99").isTrue());
+    CHECK(session.eval("W[299] == 100'b11 << 98").isTrue());
+    CHECK(session.eval("W[1]").integer() == 0);
+    NO_SESSION_ERRORS;
+}
+
+TEST_CASE("Functions with many locals") {
+    ScriptSession session;
+    session.eval(R"(
+function automatic int many(int n);
+    int a0 = 1, a1 = 2, a2 = 3, a3 = 4, a4 = 5, a5 = 6, a6 = 7;
+    int a7 = 8, a8 = 9, a9 = 10, a10 = 11, a11 = 12, a12 = 13, a13 = 14;
+    int a14 = 15, a15 = 16, a16 = 17, a17 = 18, a18 = 19, a19 = 20;
+    int total = 0;
+    for (int i = 0; i < n; i++) begin
+        int t = i;
+        total += t + a19 - a0;
+    end
+    begin
+        int t = a10;
+        total += t;
+    end
+    return total;
+endfunction
+)");
+
+    CHECK(session.eval("many(4)").integer() == 93);
+    CHECK(session.eval("many(0)").integer() == 11);
+    NO_SESSION_ERRORS;
+}
+
 TEST_CASE("Dynamic array eval") {
     ScriptSession session;
     session.eval("int arr[] = '{1, 2, 3, 4};");
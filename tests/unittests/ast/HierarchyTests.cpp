@@ -1827,3 +1827,129 @@ endmodule
     CHECK(diags[0].code == diag::VirtualIfaceDefparam);
     CHECK(diags[1].code == diag::VirtualIfaceDefparam);
 }
+
+TEST_CASE("Instance caching shares identical bodies") {
+    auto tree = SyntaxTree::fromText(R"(
+module leaf #(parameter int P = 4);
+    logic [P-1:0] v;
+    int x = foo;
+endmodule
+
+module top;
+    leaf l[3:0]();
+    leaf #(5) m();
+    leaf #(.P(4)) n();
+endmodule
+)");
+
+    CompilationOptions options;
+    options.flags |= CompilationFlags::EnableInstanceCaching;
+
+    Compilation compilation(options);
+    compilation.addSyntaxTree(tree);
+
+    // The error is reported once and applies to every instance,
+    // so it shouldn't be coalesced to a particular instance path.
+    auto& diags = compilation.getAllDiagnostics();
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::UndeclaredIdentifier);
+    CHECK(!diags[0].coalesceCount);
+
+    auto& root = compilation.getRoot();
+    auto& arr = root.lookupName<InstanceArraySymbol>("top.l");
+    auto& l0 = arr.elements[0]->as<InstanceSymbol>();
+    CHECK(!compilation.getCanonicalBody(l0));
+    for (size_t i = 1; i < arr.elements.size(); i++) {
+        CHECK(compilation.getCanonicalBody(arr.elements[i]->as<InstanceSymbol>()) ==
+              &l0.body);
+    }
+
+    CHECK(!compilation.getCanonicalBody(root.lookupName<InstanceSymbol>("top.m")));
+    CHECK(compilation.getCanonicalBody(root.lookupName<InstanceSymbol>("top.n")) == &l0.body);
+}
+
+TEST_CASE("Instance caching with hierarchical references") {
+    auto tree = SyntaxTree::fromText(R"(
+module leaf;
+    logic v;
+    always_comb v = 0;
+endmodule
+
+module upward;
+    initial $display(top.w);
+endmodule
+
+module top;
+    logic w;
+    leaf l[2:0]();
+    upward u[1:0]();
+
+    assign l[2].v = 1;
+endmodule
+)");
+
+    CompilationOptions options;
+    options.flags |= CompilationFlags::EnableInstanceCaching;
+
+    Compilation compilation(options);
+    compilation.addSyntaxTree(tree);
+
+    // The reference into l[2] must cause it to be elaborated
+    // so that we find the multiple driver error.
+    auto& diags = compilation.getAllDiagnostics();
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::MixedVarAssigns);
+
+    auto& root = compilation.getRoot();
+    auto& l = root.lookupName<InstanceArraySymbol>("top.l");
+    CHECK(compilation.getCanonicalBody(l.elements[1]->as<InstanceSymbol>()));
+    CHECK(!compilation.getCanonicalBody(l.elements[2]->as<InstanceSymbol>()));
+
+    auto& u = root.lookupName<InstanceArraySymbol>("top.u");
+    CHECK(!compilation.getCanonicalBody(u.elements[1]->as<InstanceSymbol>()));
+}
+
+TEST_CASE("Instance caching coalesces diagnostics in nested hierarchies") {
+    auto tree = SyntaxTree::fromText(R"(
+module leaf #(parameter int P = 0);
+    if (P == 1) begin : g
+        int x = foo;
+    end
+endmodule
+
+module mid;
+    leaf #(1) a();
+    leaf #(0) b();
+endmodule
+
+module top;
+    mid m1();
+    mid m2();
+    mid m3();
+endmodule
+)");
+
+    CompilationOptions options;
+    options.flags |= CompilationFlags::EnableInstanceCaching;
+
+    Compilation compilation(options);
+    compilation.addSyntaxTree(tree);
+
+    // The error is in the 'a' instance of each of the three 'mid' instances,
+    // even though only the first one of those was actually elaborated.
+    auto& diags = compilation.getAllDiagnostics();
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::UndeclaredIdentifier);
+    CHECK(diags[0].coalesceCount == 3);
+
+    auto& root = compilation.getRoot();
+    auto& m1 = root.lookupName<InstanceSymbol>("top.m1");
+    CHECK(compilation.getCanonicalBody(root.lookupName<InstanceSymbol>("top.m3")) == &m1.body);
+
+    // The result is the same as without instance caching.
+    Compilation uncached;
+    uncached.addSyntaxTree(tree);
+    auto& uncachedDiags = uncached.getAllDiagnostics();
+    REQUIRE(uncachedDiags.size() == 1);
+    CHECK(uncachedDiags[0].coalesceCount == 3);
+}
@@ -650,6 +650,116 @@ endmodule
     NO_COMPILATION_ERRORS;
 }
 
+TEST_CASE("Constant function call results are cached") {
+    auto tree = SyntaxTree::fromText(R"(
+package p;
+    function automatic int clog2(int value);
+        int result = 0;
+        for (value = value - 1; value > 0; value >>= 1)
+            result++;
+        return result;
+    endfunction
+endpackage
+
+module n #(parameter int W);
+    localparam int L = p::clog2(W);
+endmodule
+
+module m;
+    n #(16) n1();
+    n #(16) n2();
+    n #(16) n3();
+    n #(100) n4();
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& root = compilation.getRoot();
+    CHECK(root.lookupName<ParameterSymbol>("m.n1.L").getValue().integer() == 4);
+    CHECK(root.lookupName<ParameterSymbol>("m.n3.L").getValue().integer() == 4);
+    CHECK(root.lookupName<ParameterSymbol>("m.n4.L").getValue().integer() == 7);
+
+    auto stats = compilation.getConstantCallStats();
+    CHECK(stats.hits == 2);
+    CHECK(stats.misses == 2);
+}
+
+TEST_CASE("Constant function call cache skips nested calls and large arguments") {
+    auto tree = SyntaxTree::fromText(R"(
+package p;
+    function automatic int inner(int x);
+        return x * 2;
+    endfunction
+
+    function automatic int outer(int x);
+        return inner(x) + inner(x + 1);
+    endfunction
+
+    function automatic int sum(int values[300]);
+        int result = 0;
+        foreach (values[i])
+            result += values[i];
+        return result;
+    endfunction
+endpackage
+
+module n;
+    localparam int V[300] = '{default: 2};
+    localparam int A = p::outer(3);
+    localparam int S = p::sum(V);
+endmodule
+
+module m;
+    n n1();
+    n n2();
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& root = compilation.getRoot();
+    CHECK(root.lookupName<ParameterSymbol>("m.n2.A").getValue().integer() == 14);
+    CHECK(root.lookupName<ParameterSymbol>("m.n2.S").getValue().integer() == 600);
+
+    // Only the outer calls to 'outer' go through the cache.
+    auto stats = compilation.getConstantCallStats();
+    CHECK(stats.hits == 1);
+    CHECK(stats.misses == 1);
+}
+
+TEST_CASE("Cached constant function results respect parameter ordering") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    localparam int A = f(1);
+    localparam int Q = 5;
+
+    function automatic int f(int x);
+        return x + Q;
+    endfunction
+
+    localparam int C = f(1);
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    // Evaluate the valid call first so that its result is cached
+    // before the call that comes ahead of Q's declaration.
+    auto& root = compilation.getRoot();
+    CHECK(root.lookupName<ParameterSymbol>("m.C").getValue().integer() == 6);
+    CHECK(root.lookupName<ParameterSymbol>("m.A").getValue().bad());
+
+    auto& diags = compilation.getAllDiagnostics();
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::ConstEvalIdUsedInCEBeforeDecl);
+}
+
 TEST_CASE("Parameter with type imported from package") {
     auto tree1 = SyntaxTree::fromText(R"(
 module m #(parameter p::foo f = "SDF") ();
@@ -0,0 +1,3 @@
+module a0;
+    b0 b();
+endmodule
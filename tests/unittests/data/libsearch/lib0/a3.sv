@@ -0,0 +1,3 @@
+module a3;
+    b3 b();
+endmodule
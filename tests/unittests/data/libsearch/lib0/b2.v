@@ -0,0 +1,2 @@
+module b2;
+endmodule
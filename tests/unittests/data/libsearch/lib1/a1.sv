@@ -0,0 +1,3 @@
+module a1;
+    b1 b();
+endmodule
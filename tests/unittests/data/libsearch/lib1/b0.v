@@ -0,0 +1,2 @@
+module b0;
+endmodule
@@ -0,0 +1,2 @@
+module b3;
+endmodule
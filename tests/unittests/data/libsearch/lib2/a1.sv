@@ -0,0 +1,3 @@
+module a1;
+    shadowed s();
+endmodule
@@ -0,0 +1,3 @@
+module a2;
+    b2 b();
+endmodule
@@ -0,0 +1,2 @@
+module b1;
+endmodule
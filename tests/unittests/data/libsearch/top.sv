@@ -0,0 +1,6 @@
+module top;
+    a0 a0();
+    a1 a1();
+    a2 a2();
+    a3 a3();
+endmodule
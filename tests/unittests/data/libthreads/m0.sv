@@ -0,0 +1,4 @@
+module m0;
+    n0 n();
+    wire w = undeclared0;
+endmodule
@@ -0,0 +1,4 @@
+module m1;
+    n1 n();
+    wire w = 1
+endmodule
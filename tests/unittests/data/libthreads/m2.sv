@@ -0,0 +1,4 @@
+module m2;
+    n2 n();
+    wire w = undeclared2;
+endmodule
@@ -0,0 +1,4 @@
+module m3;
+    n3 n();
+    wire w = 1
+endmodule
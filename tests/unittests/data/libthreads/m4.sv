@@ -0,0 +1,4 @@
+module m4;
+    n4 n();
+    wire w = undeclared4;
+endmodule
@@ -0,0 +1,4 @@
+module m5;
+    n5 n();
+    wire w = 1
+endmodule
@@ -0,0 +1,4 @@
+module m6;
+    n6 n();
+    wire w = undeclared6;
+endmodule
@@ -0,0 +1,4 @@
+module m7;
+    n7 n();
+    wire w = 1
+endmodule
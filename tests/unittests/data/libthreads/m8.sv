@@ -0,0 +1,4 @@
+module m8;
+    n8 n();
+    wire w = undeclared8;
+endmodule
@@ -0,0 +1,4 @@
+module m9;
+    n9 n();
+    wire w = 1
+endmodule
@@ -0,0 +1,3 @@
+module n0;
+    wire w = other0;
+endmodule
@@ -0,0 +1,3 @@
+module n1;
+    wire w = other1;
+endmodule
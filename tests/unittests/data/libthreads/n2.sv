@@ -0,0 +1,3 @@
+module n2;
+    wire w = other2;
+endmodule
@@ -0,0 +1,3 @@
+module n3;
+    wire w = other3;
+endmodule
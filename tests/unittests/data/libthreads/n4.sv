@@ -0,0 +1,3 @@
+module n4;
+    wire w = other4;
+endmodule
@@ -0,0 +1,3 @@
+module n5;
+    wire w = other5;
+endmodule
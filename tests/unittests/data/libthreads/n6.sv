@@ -0,0 +1,3 @@
+module n6;
+    wire w = other6;
+endmodule
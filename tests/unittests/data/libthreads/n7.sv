@@ -0,0 +1,3 @@
+module n7;
+    wire w = other7;
+endmodule
@@ -0,0 +1,3 @@
+module n8;
+    wire w = other8;
+endmodule
@@ -0,0 +1,3 @@
+module n9;
+    wire w = other9;
+endmodule
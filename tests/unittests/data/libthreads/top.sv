@@ -0,0 +1,12 @@
+module top;
+    m0 m0();
+    m1 m1();
+    m2 m2();
+    m3 m3();
+    m4 m4();
+    m5 m5();
+    m6 m6();
+    m7 m7();
+    m8 m8();
+    m9 m9();
+endmodule
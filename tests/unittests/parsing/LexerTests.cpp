@@ -268,6 +268,41 @@ TEST_CASE("Mixed Identifiers") {
     CHECK_DIAGNOSTICS_EMPTY;
 }
 
+TEST_CASE("Long identifiers") {
+    // Long enough to cross several of the lexer's 16 byte scanning blocks.
+    std::string text = "u_core_datapath_stage3_pipeline_reg_42_$abc_DEF_0123456789_"
+                       "u_core_datapath_stage3_pipeline_reg_42_$abc_DEF_0123456789";
+    Token token = lexToken(text + "+x");
+    CHECK(token.kind == TokenKind::Identifier);
+    CHECK(token.valueText() == text);
+    CHECK_DIAGNOSTICS_EMPTY;
+
+    token = lexToken(text + "\xe9");
+    CHECK(token.kind == TokenKind::Identifier);
+    CHECK(token.valueText() == text);
+}
+
+TEST_CASE("Long trivia") {
+    auto& text = "  \t\t  \v\f                              \t  "
+                 "// a fairly long line comment \u00F7 with UTF8 in the middle of it\r\n"
+                 "/* a long block comment with some * stars * and / slashes / that\n"
+                 "   spans multiple lines and \u7684\u6C23 non-ASCII text ** */"
+                 "                                        abc";
+    Token token = lexToken(text);
+
+    CHECK(token.kind == TokenKind::Identifier);
+    CHECK(token.valueText() == "abc");
+    CHECK(token.toString() == text);
+    REQUIRE(token.trivia().size() == 5);
+    CHECK(token.trivia()[0].kind == TriviaKind::Whitespace);
+    CHECK(token.trivia()[1].kind == TriviaKind::LineComment);
+    CHECK(token.trivia()[2].kind == TriviaKind::EndOfLine);
+    CHECK(token.trivia()[3].kind == TriviaKind::BlockComment);
+    CHECK(token.trivia()[4].kind == TriviaKind::Whitespace);
+    CHECK(token.trivia()[4].getRawText().size() == 40);
+    CHECK_DIAGNOSTICS_EMPTY;
+}
+
 TEST_CASE("Escaped Identifiers") {
     auto& text = "\\98\\#$%)(*lkjsd__09...asdf345";
     Token token = lexToken(text);
@@ -334,6 +369,18 @@ TEST_CASE("String literal") {
     CHECK_DIAGNOSTICS_EMPTY;
 }
 
+TEST_CASE("String literal (long)") {
+    auto& text = "\"a fairly long string literal with \\t an escape and \u00F7 UTF8 "
+                 "characters, long enough to span several scanning blocks\"";
+    Token token = lexToken(text);
+
+    CHECK(token.kind == TokenKind::StringLiteral);
+    CHECK(token.toString() == text);
+    CHECK(token.valueText() == "a fairly long string literal with \t an escape and \u00F7 UTF8 "
+                               "characters, long enough to span several scanning blocks");
+    CHECK_DIAGNOSTICS_EMPTY;
+}
+
 TEST_CASE("String literal (newline)") {
     auto& text = "\"literal\r\nwith new line\"";
     Token token = lexToken(text);
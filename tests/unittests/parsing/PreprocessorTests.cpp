@@ -4,6 +4,7 @@
 #include "Test.h"
 
 #include "slang/parsing/Preprocessor.h"
+#include "slang/parsing/TokenCache.h"
 #include "slang/syntax/AllSyntax.h"
 #include "slang/syntax/SyntaxPrinter.h"
 #include "slang/text/SourceManager.h"
@@ -97,6 +98,102 @@ TEST_CASE("Double include, with pragma once") {
     CHECK_DIAGNOSTICS_EMPTY;
 }
 
+TEST_CASE("Double include, with include guard") {
+    auto& text = R"(
+`include "include_guard.svh"
+`include "include_guard.svh"
+`undef INCLUDE_GUARD_SVH
+`include "include_guard.svh"
+)";
+
+    diagnostics.clear();
+    Preprocessor preprocessor(getSourceManager(), alloc, diagnostics);
+    preprocessor.pushSource(text);
+
+    std::string result;
+    size_t numDirectives = 0;
+    while (true) {
+        Token token = preprocessor.next();
+        result += token.toString();
+        for (auto& trivia : token.trivia()) {
+            if (trivia.kind == TriviaKind::Directive)
+                numDirectives++;
+        }
+
+        if (token.kind == TokenKind::EndOfFile)
+            break;
+    }
+
+    CHECK(std::ranges::count(result, '"') == 4);
+    CHECK_DIAGNOSTICS_EMPTY;
+
+    // The second include should be skipped entirely, so its `ifndef and `endif
+    // directives don't show up: 4 directives for each of the first and third
+    // includes, plus the second include itself and the `undef.
+    CHECK(numDirectives == 10);
+}
+
+TEST_CASE("Double include, not an include guard") {
+    auto& text = R"(
+`include "not_a_guard.svh"
+`include "not_a_guard.svh"
+)";
+    auto& expected = R"(
+"first string"
+"second string"
+)";
+
+    std::string result = preprocess(text);
+    result.erase(std::remove(result.begin(), result.end(), '\r'), result.end());
+
+    CHECK(result == expected);
+    CHECK_DIAGNOSTICS_EMPTY;
+}
+
+TEST_CASE("Includes with shared token cache") {
+    auto& text = R"(
+`include "local.svh"
+`include "include_guard.svh"
+)";
+
+    std::string expected = preprocess(text);
+    CHECK_DIAGNOSTICS_EMPTY;
+
+    PreprocessorOptions ppOptions;
+    ppOptions.tokenCache = std::make_shared<TokenCache>();
+
+    Bag options;
+    options.set(ppOptions);
+
+    // The first run fills the cache and the second replays from it;
+    // both should see exactly the same tokens as without the cache.
+    for (int i = 0; i < 2; i++) {
+        diagnostics.clear();
+        Preprocessor preprocessor(getSourceManager(), alloc, diagnostics, options);
+        preprocessor.pushSource(text);
+
+        std::string result;
+        while (true) {
+            Token token = preprocessor.next();
+            result += token.toString();
+
+            // Replayed tokens must refer to this preprocessor's buffers.
+            auto& sm = getSourceManager();
+            if (token.kind == TokenKind::StringLiteral) {
+                CHECK(sm.getSourceText(token.location().buffer()).substr(
+                          token.location().offset(), token.rawText().length()) ==
+                      token.rawText());
+            }
+
+            if (token.kind == TokenKind::EndOfFile)
+                break;
+        }
+
+        CHECK(result == expected);
+        CHECK_DIAGNOSTICS_EMPTY;
+    }
+}
+
 TEST_CASE("Include directive errors") {
     auto& text = R"(
 `include
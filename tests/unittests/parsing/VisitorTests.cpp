@@ -7,7 +7,10 @@
 #include "slang/ast/ASTVisitor.h"
 #include "slang/parsing/ParserMetadata.h"
 #include "slang/syntax/SyntaxPrinter.h"
+#include "slang/syntax/SyntaxSerializer.h"
 #include "slang/syntax/SyntaxVisitor.h"
+#include "slang/text/SourceManager.h"
+#include "slang/util/Hash.h"
 
 class SemanticModel {
 public:
@@ -685,3 +688,131 @@ TEST_CASE("Visit all file") {
 
     CHECK(count == 1456);
 }
+
+TEST_CASE("Syntax tree serialization round trip") {
+    auto text = R"(
+`timescale 1ns/1ps
+// A comment
+module m #(parameter real p = 1.5e3)(input logic [3:0] a, output wire b);
+    localparam int q = 32'sh7fff_ffff + 128'hffff_0000_ffff_0000_ffff_0000_x;
+    string s = "hello\tworld";
+    logic c = 'z;
+    initial #10ns $display("%d", a);
+    assign b = |a;
+`ifdef FOO
+    garbage here
+`endif
+endmodule
+)";
+
+    SourceManager sm;
+    auto buffer = sm.assignText(text);
+    auto tree = SyntaxTree::fromBuffer(buffer, sm);
+    REQUIRE(tree->diagnostics().empty());
+
+    SmallVector<char> data;
+    REQUIRE(SyntaxSerializer::serialize(*tree, buffer, data));
+
+    auto result = SyntaxSerializer::deserialize(data, buffer, sm, {});
+    REQUIRE(result);
+    CHECK(SyntaxPrinter::printFile(*result) == SyntaxPrinter::printFile(*tree));
+
+    auto& unit = result->root().as<CompilationUnitSyntax>();
+    auto& module = unit.members[0]->as<ModuleDeclarationSyntax>();
+    CHECK(module.header->name.valueText() == "m");
+    CHECK(module.header->name.location() == module.getFirstToken().location() + 7);
+    CHECK(module.getFirstToken().location().buffer() == buffer.id);
+
+    auto& meta = result->getMetadata();
+    REQUIRE(meta.nodeMap.size() == 1);
+    CHECK(meta.nodeMap.begin()->second.timeScale.has_value());
+
+    // Corrupted data should be rejected rather than crash.
+    data.back() ^= 1;
+    CHECK(!SyntaxSerializer::deserialize(data, buffer, sm, {}));
+    CHECK(!SyntaxSerializer::deserialize(std::span(data.data(), 4), buffer, sm, {}));
+}
+
+TEST_CASE("Syntax tree serialization keeps preprocessor state") {
+    auto text = R"(
+module m(input a, b, output c);
+    assign w = a & b;
+    assign c = w;
+endmodule
+
+`default_nettype none
+`unconnected_drive pull1
+module n;
+    assign x = 1;
+endmodule
+`nounconnected_drive
+`resetall
+)";
+
+    SourceManager sm;
+    auto buffer = sm.assignText(text);
+    auto tree = SyntaxTree::fromBuffer(buffer, sm);
+    REQUIRE(tree->diagnostics().empty());
+
+    SmallVector<char> data;
+    REQUIRE(SyntaxSerializer::serialize(*tree, buffer, data));
+
+    auto result = SyntaxSerializer::deserialize(data, buffer, sm, {});
+    REQUIRE(result);
+
+    auto& unit = result->root().as<CompilationUnitSyntax>();
+    auto& meta = result->getMetadata().nodeMap;
+    REQUIRE(meta.size() == 2);
+    CHECK(meta.at(unit.members[0]).defaultNetType == TokenKind::WireKeyword);
+    CHECK(meta.at(unit.members[1]).defaultNetType == TokenKind::Unknown);
+    CHECK(meta.at(unit.members[1]).unconnectedDrive == TokenKind::Pull1Keyword);
+
+    // The implicit net in m is fine, but x in n is an error.
+    Compilation compilation;
+    compilation.addSyntaxTree(result);
+
+    auto& diags = compilation.getAllDiagnostics();
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::UndeclaredIdentifier);
+}
+
+TEST_CASE("Syntax tree deserialization rejects malformed payloads") {
+    SourceManager sm;
+    auto buffer = sm.assignText(R"(
+module m #(parameter p = 8'hff)(input [3:0] a);
+    logic [p-1:0] b = "str";
+endmodule
+)");
+    auto tree = SyntaxTree::fromBuffer(buffer, sm);
+
+    SmallVector<char> data;
+    REQUIRE(SyntaxSerializer::serialize(*tree, buffer, data));
+
+    // Truncate the payload at every point and give it a matching hash, so that
+    // it gets past the header check and into the reader.
+    constexpr size_t HeaderSize = 16;
+    for (size_t size = HeaderSize; size < data.size(); size++) {
+        std::vector<char> copy(data.begin(), data.begin() + ptrdiff_t(size));
+        uint64_t hash = slang::detail::hashing::hash(copy.data() + HeaderSize,
+                                                     size - HeaderSize);
+        memcpy(copy.data() + 8, &hash, sizeof(hash));
+        CHECK(!SyntaxSerializer::deserialize(copy, buffer, sm, {}));
+    }
+}
+
+TEST_CASE("Syntax tree serialization of unsupported trees") {
+    auto check = [](std::string_view text) {
+        SourceManager sm;
+        auto buffer = sm.assignText(text);
+        auto tree = SyntaxTree::fromBuffer(buffer, sm);
+
+        SmallVector<char> data;
+        return SyntaxSerializer::serialize(*tree, buffer, data);
+    };
+
+    CHECK(check("module m; endmodule"));
+    CHECK(!check("`define FOO 1\nmodule m; int i = `FOO; endmodule"));
+    CHECK(!check("`include \"foo.svh\"\nmodule m; endmodule"));
+    CHECK(!check("`line 5 \"foo.sv\" 0\nmodule m; endmodule"));
+    CHECK(!check("module m; int i = ; endmodule"));
+}
@@ -242,6 +242,17 @@ TEST_CASE("SVInt to string (and back)") {
     CHECK("4'bxxxx"_si.toString(LiteralBase::Hex, false) == "x");
     CHECK("4'bzzzz"_si.toString(LiteralBase::Hex, false) == "z");
     CHECK("4'bzz1z"_si.toString(LiteralBase::Hex, false) == "Z");
+
+    // Large values are converted to and from decimal by splitting them in half,
+    // which needs the zeros at the front of each lower half to be kept.
+    SVInt big = SVInt(140000, 10, false).pow(SVInt(32, 40000, false));
+    CHECK(big.toString(LiteralBase::Decimal, false) == "1" + std::string(40000, '0'));
+    CHECK((big + 7).toString(LiteralBase::Decimal, false) ==
+          "1" + std::string(39999, '0') + "7");
+    CHECK(SVInt::fromString("140000'd" + std::string(40000, '9')) == big - 1);
+    CHECK(SVInt::fromString("8'd" + std::string(40000, '9')) == 255);
+    auto str = "-140000'sd" + std::string(40000, '8') + "1";
+    CHECK(SVInt::fromString(str).toString(LiteralBase::Decimal, true) == str);
 }
 
 TEST_CASE("Comparison") {
@@ -309,6 +320,12 @@ TEST_CASE("Arithmetic") {
     CHECK("-120'sd999987654321"_si * "0"_si == 0);
     CHECK("0"_si * "-120'sd999987654321"_si == 0);
 
+    // Operands of very different sizes are multiplied in pieces.
+    SVInt one(5600, 1, false);
+    SVInt shortVal = one.shl(599) + 1;
+    SVInt longVal = one.shl(4999) + 3;
+    CHECK(shortVal * longVal == one.shl(5598) + one.shl(4999) + one.shl(599) * 3 + 3);
+
     CHECK_THAT("100'bx"_si + "98'bx"_si, exactlyEquals("100'bx"_si));
     CHECK_THAT("100'bx"_si - "98'bx"_si, exactlyEquals("100'bx"_si));
     CHECK_THAT("100'bx"_si * "98'bx"_si, exactlyEquals("100'bx"_si));
@@ -491,7 +508,7 @@ TEST_CASE("Shifting") {
     CHECK("64"_si.shl(3) == 512);
 
     CHECK("129'd12341234"_si.shl(SVInt(129)) == 0);
-    CHECK("129'd12341234"_si.shl(129) == 0);
+    CHECK("129'd12341234"_si.shl(131) == 0);
     CHECK("129'd12341234"_si.shl(0) == "129'd12341234"_si);
     CHECK("129'b1"_si.shl(1) == "129'b10"_si);
 
@@ -590,6 +607,13 @@ TEST_CASE("Slicing") {
     v2.set(100, 0, SVInt(101, 0, false));
     CHECK(v2 == 0);
 
+    // Setting unknown bits must keep the rest of the known value.
+    SVInt v5 = "200'hfedcba9876543210fedcba9876543210fedcba9876543210"_si;
+    v5.set(3, 0, "4'bx01z"_si);
+    CHECK_THAT(v5.slice(199, 4),
+               exactlyEquals("196'hfedcba9876543210fedcba9876543210fedcba987654321"_si));
+    CHECK_THAT(v5.slice(3, 0), exactlyEquals("4'bx01z"_si));
+
     // Test huge values
     SVInt v3 =
         ("16777215'd999999999999999999999999999999999999999999999999999999999999999999999999999999999999999"_si
@@ -834,3 +858,67 @@ value = value >> 1
     compilation.addSyntaxTree(tree);
     compilation.getAllDiagnostics();
 }
+
+TEST_CASE("Dense array values") {
+    // Four-state elements narrower than a word share words with their neighbors.
+    SVDenseArray narrow(100, SVInt::createFillX(12, false), /* isFourState */ true);
+    CHECK(narrow.size() == 100);
+    CHECK(narrow.hasUnknown());
+    CHECK(narrow.get(57).toString(LiteralBase::Hex) == "12'hxxx");
+
+    for (size_t i = 0; i < narrow.size(); i++)
+        narrow.set(i, SVInt(12, i * 41, false));
+    CHECK(!narrow.hasUnknown());
+    CHECK(narrow.get(4) == 164);
+    CHECK(narrow.get(99) == (99 * 41) % 4096);
+
+    narrow.set(5, "12'b1010zzzzxxxx"_si);
+    CHECK(exactlyEqual(narrow.get(5), "12'b1010zzzzxxxx"_si));
+    CHECK(narrow.get(4) == 164);
+    CHECK(narrow.get(6) == 246);
+
+    // Converting to and from element lists round trips, and the two forms compare equal.
+    ConstantValue packed = narrow;
+    ConstantValue unpacked = narrow.unpack();
+    CHECK(packed.size() == 100);
+    CHECK(packed == unpacked);
+    CHECK(unpacked == packed);
+    CHECK(packed.hash() == unpacked.hash());
+    CHECK(packed.getBitstreamWidth() == 1200);
+    CHECK(packed.getSlice(6, 4, nullptr) == unpacked.getSlice(6, 4, nullptr));
+    CHECK(SVDenseArray::canPack(unpacked.elements()));
+    CHECK(ConstantValue(SVDenseArray::pack(unpacked.elements(), true).unpack()) == unpacked);
+
+    size_t count = 0;
+    const ConstantValue& cpacked = packed;
+    for (auto it = begin(cpacked); it != end(cpacked); ++it) {
+        CHECK(*it == unpacked.elements()[count]);
+        count++;
+    }
+    CHECK(count == 100);
+
+    // Two-state storage has no room for unknowns and reads them back as zero.
+    SVDenseArray twoState(10, SVInt(8, 0, true), /* isFourState */ false);
+    twoState.set(3, "8'sb1111xxzz"_si);
+    CHECK(!twoState.hasUnknown());
+    CHECK(twoState.get(3) == -16);
+    CHECK(twoState.get(3).isSigned());
+
+    // Elements wider than a word get a run of words each.
+    SVDenseArray wide(5, SVInt(132, 0, false), /* isFourState */ true);
+    wide.set(2, "132'hx0000000000000000ffffffffffffffff"_si);
+    wide.set(3, SVInt(132, 1, false).shl(131));
+    CHECK(wide.get(1) == 0);
+    CHECK(exactlyEqual(wide.get(2), "132'hx0000000000000000ffffffffffffffff"_si));
+    CHECK(wide.get(3) == SVInt(132, 1, false).shl(131));
+
+    auto slice = ConstantValue(wide).getSlice(3, 1, nullptr);
+    auto elems = slice.elements();
+    REQUIRE(elems.size() == 3);
+    CHECK(exactlyEqual(elems[1].integer(), wide.get(2)));
+
+    // Mismatched element lists are rejected.
+    std::vector<ConstantValue> mixed{SVInt(12, 1, false), SVInt(13, 1, false)};
+    CHECK(!SVDenseArray::canPack(mixed));
+    CHECK(!narrow.assign(mixed));
+}
@@ -263,6 +263,54 @@ TEST_CASE("ThreadPool -- pushLoop") {
     CHECK(std::ranges::all_of(flags10, [](auto&& f) -> bool { return f; }));
 }
 
+TEST_CASE("ThreadPool -- pushLoop uneven work") {
+    ThreadPool pool(4);
+
+    // Every index should be visited exactly once, even when
+    // some iterations are much more expensive than others.
+    std::array<std::atomic<int>, 1000> counts;
+    std::ranges::fill(counts, 0);
+
+    pool.pushLoop(size_t(0), counts.size(), [&](size_t start, size_t end) {
+        for (size_t i = start; i < end; i++) {
+            if (i < 4)
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            counts[i]++;
+        }
+    });
+    pool.waitForAll();
+    CHECK(std::ranges::all_of(counts, [](auto&& c) -> bool { return c == 1; }));
+}
+
+TEST_CASE("ThreadPool -- nested tasks") {
+    ThreadPool pool(2);
+
+    std::atomic<int> count = 0;
+    int seenInTask = -1;
+    pool.pushTask([&] {
+        for (int i = 0; i < 100; i++)
+            pool.pushTask([&count] { count++; });
+
+        // Waiting from within a task helps run the nested tasks.
+        pool.waitForAll();
+        seenInTask = count;
+    });
+
+    pool.waitForAll();
+    CHECK(seenInTask == 100);
+    CHECK(count == 100);
+
+    std::atomic<size_t> total = 0;
+    pool.pushLoop(0, 8, [&](int start, int end) {
+        for (int i = start; i < end; i++) {
+            pool.pushLoop(0, 10, [&](int s, int e) { total += size_t(e - s); });
+            pool.waitForAll();
+        }
+    });
+    pool.waitForAll();
+    CHECK(total == 80);
+}
+
 #ifdef CI_BUILD
 
 TEST_CASE("ThreadPool -- no destruction deadlocks") {
@@ -23,6 +23,7 @@
 using namespace slang;
 using namespace slang::ast;
 using namespace slang::driver;
+using namespace slang::syntax;
 
 void printJson(Compilation& compilation, const std::string& fileName,
                const std::vector<std::string>& scopes) {
@@ -139,32 +140,47 @@ int driverMain(int argc, TArgs argv) {
             TimeTrace::initialize();
 
         bool ok = true;
+        std::unique_ptr<Compilation> compilation;
         SLANG_TRY {
             if (onlyPreprocess == true) {
-                ok = driver.runPreprocessor(includeComments == true, includeDirectives == true,
-                                            obfuscateIds == true);
+                driver.measurePhase("preprocess"sv, [&] {
+                    ok = driver.runPreprocessor(includeComments == true, includeDirectives == true,
+                                                obfuscateIds == true);
+                });
             }
             else if (onlyMacros == true) {
                 driver.reportMacros();
             }
             else if (onlyParse == true) {
-                ok = driver.parseAllSources();
-                ok &= driver.reportParseDiags();
+                driver.measurePhase("parse"sv, [&] {
+                    ok = driver.parseAllSources();
+                    ok &= driver.reportParseDiags();
+                });
             }
             else {
                 {
                     TimeTraceScope timeScope("parseAllSources"sv, ""sv);
-                    ok = driver.parseAllSources();
+                    driver.measurePhase("parse"sv, [&] { ok = driver.parseAllSources(); });
                 }
 
                 {
                     TimeTraceScope timeScope("elaboration"sv, ""sv);
-                    auto compilation = driver.createCompilation();
-                    ok &= driver.reportCompilation(*compilation, quiet == true);
+                    driver.measurePhase("elaborate"sv, [&] {
+                        compilation = driver.createCompilation();
+                        compilation->getRoot();
+                    });
+
+                    driver.measurePhase("analysis"sv, [&] {
+                        ok &= driver.reportCompilation(*compilation, quiet == true);
+                    });
+
                     if (astJsonFile)
                         printJson(*compilation, *astJsonFile, astJsonScopes);
                 }
             }
+
+            if (driver.options.showStats == true)
+                driver.reportStats(compilation.get());
         }
         SLANG_CATCH(const std::exception& e) {
 #if __cpp_exceptions
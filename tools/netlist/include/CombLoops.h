@@ -52,129 +52,21 @@ int count_vec_if(const std::vector<T>& vec, Predicate predicate) {
     return std::count_if(vec.cbegin(), vec.cend(), predicate);
 }
 
-class SCCResult {
-private:
-    std::vector<std::vector<ID_type>> adjList;
-    ID_type lowestNodeId;
-
-public:
-    SCCResult(std::vector<std::vector<ID_type>>& adjList, ID_type lowestNodeId) :
-        adjList(adjList), lowestNodeId(lowestNodeId) {}
-    SCCResult(std::vector<std::vector<ID_type>>& adjList) : adjList(adjList), lowestNodeId(-1) {}
-    SCCResult() : lowestNodeId(-1) {}
-    inline std::vector<std::vector<ID_type>>& getAdjListForWrite() { return adjList; }
-    inline const std::vector<std::vector<ID_type>>& getAdjList() const { return adjList; }
-    inline const ID_type getLowestNodeId() const { return lowestNodeId; }
-    inline void setLowestNodeId(ID_type node_id) { lowestNodeId = node_id; }
-    inline bool isEmpty() const { return lowestNodeId == -1; }
-};
-
 /**
- * This is a helpclass for the search of all elementary cycles in a graph
- * with the algorithm of Johnson. For this it searches for strong connected
- * components, using the algorithm of Tarjan. The constructor gets an
- * adjacency-list of a graph. Based on this graph, it gets a nodenumber s,
- * for which it calculates the subgraph, containing all nodes
- * {s, s + 1, ..., n}, where n is the highest nodenumber in the original
- * graph (e.g. it builds a subgraph with all nodes with higher or same
- * nodenumbers like the given node s). It returns the strong connected
- * component of this subgraph which contains the lowest nodenumber of all
- * nodes in the subgraph.<br><br>
- *
- * For a description of the algorithm for calculating the strong connected
- * components see:<br>
- * Robert Tarjan: Depth-first search and linear graph algorithms. In: SIAM
- * Journal on Computing. Volume 1, Nr. 2 (1972), pp. 146-160.<br>
- * For a description of the algorithm for searching all elementary cycles in
- * a directed graph see:<br>
+ * Searchs all elementary cycles in a given directed graph, using the
+ * algorithm of Donald B. Johnson. For a description of the algorithm see:<br>
  * Donald B. Johnson: Finding All the Elementary Circuits of a Directed Graph.
  * SIAM Journal on Computing. Volumne 4, Nr. 1 (1975), pp. 77-84.<br><br>
  *
- * @author Frank Meyer, web_at_normalisiert_dot_de
- * @version 1.1, 22.03.2009
- *
- */
-
-class StrongConnectedComponents {
-private:
-    /** Adjacency-list of original graph */
-    std::vector<std::vector<ID_type>>& adjListOriginal;
-
-    /** Adjacency-list of currently viewed subgraph */
-    /* node IDs are the same as the original, but some of the nodes will be filtered, below a
-     * specific node ID*/
-    std::vector<std::vector<ID_type>> adjList;
-
-    /** Helpattribute for finding scc's */
-    std::vector<bool> visited;
-
-    /** Helpattribute for finding scc's */
-    std::vector<int> stack;
-
-    /** Helpattribute for finding scc's */
-    std::vector<int> lowlink;
-
-    /** Helpattribute for finding scc's */
-    std::vector<int> number;
-
-    /** Helpattribute for finding scc's */
-    int sccCounter = 0;
-
-    /** Helpattribute for finding scc's */
-    std::vector<std::vector<ID_type>> currentSCCs;
-
-    // we only need one object at a time
-    SCCResult sccr_current;
-
-public:
-    static SCCResult sccr_dummy;
-    /**
-     * Constructor.
-     *
-     * @param adjList adjacency-list of the graph
-     */
-    StrongConnectedComponents(std::vector<std::vector<ID_type>>& adjList) :
-        adjListOriginal(adjList) {};
-
-    /**
-     * This method returns the adjacency-structure of the strong connected
-     * component with the least vertex in a subgraph of the original graph
-     * induced by the nodes {s, s + 1, ..., n}, where s is a given node. Note
-     * that trivial strong connected components with just one node will not
-     * be returned.
-     *
-     * @param node node s
-     * @return SCCResult with adjacency-structure of the strong
-     * connected component; null, if no such component exists
-     */
-    SCCResult& getAdjacencyList(ID_type node);
-
-private:
-    void makeAdjListSubgraph(const ID_type node);
-    const std::vector<ID_type>* getLowestIdComponent() const;
-    void buildAdjList(const std::vector<ID_type>& nodes, SCCResult& sccr) const;
-    void getStrongConnectedComponents(ID_type root);
-};
-
-/**
- * Searchs all elementary cycles in a given directed graph. The implementation
- * is independent from the concrete objects that represent the graphnodes, it
- * just needs an array of the objects representing the nodes the graph
- * and an adjacency-matrix of type boolean, representing the edges of the
- * graph. It then calculates based on the adjacency-matrix the elementary
- * cycles and returns a list, which contains lists itself with the objects of the
- * concrete graphnodes-implementation. Each of these lists represents an
- * elementary cycle.<br><br>
- *
- * The implementation uses the algorithm of Donald B. Johnson for the search of
- * the elementary cycles. For a description of the algorithm see:<br>
- * Donald B. Johnson: Finding All the Elementary Circuits of a Directed Graph.
- * SIAM Journal on Computing. Volumne 4, Nr. 1 (1975), pp. 77-84.<br><br>
- *
- * The algorithm of Johnson is based on the search for strong connected
- * components in a graph. For a description of this part see:<br>
+ * Every elementary cycle lies entirely within one strongly connected
+ * component of the graph, so the graph is first split into its strongly
+ * connected components with the algorithm of Tarjan, see:<br>
  * Robert Tarjan: Depth-first search and linear graph algorithms. In: SIAM
- * Journal on Computing. Volume 1, Nr. 2 (1972), pp. 146-160.<br>
+ * Journal on Computing. Volume 1, Nr. 2 (1972), pp. 146-160.<br><br>
+ *
+ * The components are then searched for cycles independently of each other,
+ * in parallel, optionally stopping after a given number of cycles have been
+ * found in any one component.
  *
  * @author Frank Meyer, web_at_normalisiert_dot_de
  * @version 1.2, 22.03.2009
@@ -190,54 +82,51 @@ private:
     /** Adjacency-list of graph */
     std::vector<std::vector<ID_type>> adjList;
 
-    /** Blocked nodes, used by the algorithm of Johnson */
-    std::vector<bool> blocked;
+    /** Strongly connected components with more than one node */
+    std::vector<std::vector<ID_type>> components;
+    bool componentsFound = false;
 
-    /** B-Lists, used by the algorithm of Johnson */
-    std::vector<std::vector<ID_type>> B;
-
-    /** Stack for nodes, used by the algorithm of Johnson */
-    std::vector<ID_type> stack;
+    /** Indices of the components that had more cycles than the limit */
+    std::vector<size_t> truncatedComponents;
 
 public:
     /**
      * Constructor.
      *
-     * @param matrix adjacency-matrix of the graph
      * @param netlist pointer to the full netlist
      */
     ElementaryCyclesSearch(Netlist& netlist);
+    /**
+     * Returns the strongly connected components of the graph that have more
+     * than one node, or a single node with an edge to itself, ordered by
+     * their lowest node ID. The nodes in each
+     * component are sorted by ID. Every elementary cycle lies entirely within
+     * one of these components.
+     */
+    const std::vector<std::vector<ID_type>>& getStronglyConnectedComponents();
     /**
      * Returns List::List::Object with the Lists of nodes of all elementary
      * cycles in the graph.
      *
+     * @param maxCyclesPerComponent if not zero, the search of each strongly
+     * connected component stops after this many cycles have been found in it.
+     * @param numThreads the number of threads to use for searching components,
+     * or zero to use one per hardware thread.
      * @return List::List::Object with the Lists of the elementary cycles.
      */
-    std::vector<CycleListType>* getElementaryCycles();
+    std::vector<CycleListType>* getElementaryCycles(size_t maxCyclesPerComponent = 0,
+                                                    unsigned numThreads = 0);
+    /**
+     * Returns the indices, into the list returned by
+     * getStronglyConnectedComponents(), of the components that had more cycles
+     * than the limit in the last call to getElementaryCycles().
+     */
+    const std::vector<size_t>& getTruncatedComponents() const { return truncatedComponents; }
     /**
      * Dumps the cycles found
      */
     static void getHierName(NetlistNode& node, std::string& buffer);
     void dumpAdjList(Netlist& netlist);
-
-private:
-    /**
-     * Calculates the cycles containing a given node in a strongly connected
-     * component. The method calls itself recursivly.
-     *
-     * @param v
-     * @param s
-     * @param adjList adjacency-list with the subgraph of the strongly
-     * connected component s is part of.
-     * @return true, if cycle found; false otherwise
-     */
-    bool findCycles(ID_type v, ID_type s, const std::vector<std::vector<ID_type>>& adjList);
-    /**
-     * Unblocks recursivly all blocked nodes, starting with a given node.
-     *
-     * @param node node to unblock
-     */
-    void unblock(ID_type node);
 };
 
 #endif // COMBLOOPS_H
@@ -22,10 +22,17 @@ struct select_all {
 
 /// Depth-first search on a directed graph. A visitor class provides visibility
 /// to the caller of visits to edges and nodes. An optional edge predicate
-/// selects which edges can be included in the traversal.
+/// selects which edges can be included in the traversal. The search can run
+/// either over the graph itself or over a CompactGraph snapshot of it, which
+/// visits nodes and edges in the same order but is considerably faster on
+/// large graphs. When searching a compact graph, a visitor whose visitEdge
+/// method also takes the source and target node descriptors is passed them
+/// directly, so that it doesn't need to look them up.
 template<class NodeType, class EdgeType, class Visitor, class EdgePredicate = select_all>
 class DepthFirstSearch {
 public:
+    using CompactGraphType = CompactGraph<NodeType, EdgeType>;
+
     DepthFirstSearch(Visitor& visitor, NodeType& startNode) : visitor(visitor) {
         setup(startNode);
         run();
@@ -37,7 +44,18 @@ public:
         run();
     }
 
+    DepthFirstSearch(Visitor& visitor, const CompactGraphType& graph, NodeType& startNode) :
+        visitor(visitor) {
+        runCompact(graph, graph.getNodeId(startNode));
+    }
+
+    DepthFirstSearch(Visitor& visitor, EdgePredicate edgePredicate, const CompactGraphType& graph,
+                     NodeType& startNode) : visitor(visitor), edgePredicate(edgePredicate) {
+        runCompact(graph, graph.getNodeId(startNode));
+    }
+
 private:
+    using CompactNodeType = typename CompactGraphType::node_descriptor;
     using EdgeIteratorType = typename NodeType::iterator;
     using VisitStackElement = std::pair<NodeType&, EdgeIteratorType>;
 
@@ -72,6 +90,46 @@ private:
         }
     }
 
+    /// Perform a depth-first traversal of a compact graph, using its node
+    /// descriptors to track visited nodes and an explicit stack of positions
+    /// in each node's edge list.
+    void runCompact(const CompactGraphType& graph, CompactNodeType start) {
+        std::vector<bool> visited(graph.numNodes());
+        std::vector<std::pair<CompactNodeType, size_t>> stack;
+
+        visited[start] = true;
+        stack.emplace_back(start, 0);
+        visitor.visitNode(graph.getNode(start));
+
+        while (!stack.empty()) {
+            auto [node, index] = stack.back();
+            auto successors = graph.getSuccessors(node);
+            auto edges = graph.getEdges(node);
+
+            // Find the next child node that hasn't already been visited.
+            while (index < successors.size() &&
+                   (visited[successors[index]] || !edgePredicate(*edges[index]))) {
+                index++;
+            }
+
+            if (index == successors.size()) {
+                // All children of this node have been visited or skipped.
+                stack.pop_back();
+                continue;
+            }
+
+            auto target = successors[index];
+            stack.back().second = index + 1;
+            stack.emplace_back(target, 0);
+            visited[target] = true;
+            if constexpr (requires { visitor.visitEdge(*edges[index], node, target); })
+                visitor.visitEdge(*edges[index], node, target);
+            else
+                visitor.visitEdge(*edges[index]);
+            visitor.visitNode(graph.getNode(target));
+        }
+    }
+
 private:
     Visitor& visitor;
     EdgePredicate edgePredicate;
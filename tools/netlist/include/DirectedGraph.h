@@ -11,8 +11,10 @@
 #include <cassert>
 #include <limits>
 #include <memory>
+#include <span>
 #include <vector>
 
+#include "slang/util/Hash.h"
 #include "slang/util/Util.h"
 
 namespace netlist {
@@ -217,6 +219,7 @@ public:
             // The node is not in the graph.
             return false;
         }
+        onRemoveNode(nodeToRemove);
         // Remove incoming edges to node for removal.
         std::vector<EdgeType*> edgesToRemove;
         for (auto& node : nodes) {
@@ -291,7 +294,96 @@ public:
     }
 
 protected:
+    /// Called by removeNode() before the specified node is removed, so that a
+    /// derived graph can drop any other references it keeps to the node.
+    virtual void onRemoveNode(NodeType&) {}
+
     NodeListType nodes;
 };
 
+/// A frozen snapshot of a directed graph in compressed sparse row form.
+/// Nodes are identified by their index in the original graph, and the
+/// outgoing edges of each node are stored contiguously as the indices of
+/// their target nodes, so that traversals can use plain vectors indexed by
+/// node instead of chasing pointers and keeping sets of visited nodes.
+/// The snapshot does not track later changes to the graph it was built from.
+template<class NodeType, class EdgeType>
+class CompactGraph {
+public:
+    using node_descriptor = uint32_t;
+    static constexpr node_descriptor null_node = std::numeric_limits<node_descriptor>::max();
+
+    /// Build a snapshot of all the nodes and edges in @a graph.
+    explicit CompactGraph(const DirectedGraph<NodeType, EdgeType>& graph) :
+        CompactGraph(graph, [](const EdgeType&) { return true; }) {}
+
+    /// Build a snapshot of all the nodes in @a graph, including only the
+    /// edges selected by @a edgePredicate.
+    template<typename EdgePredicate>
+    CompactGraph(const DirectedGraph<NodeType, EdgeType>& graph, EdgePredicate edgePredicate) {
+        SLANG_ASSERT(graph.numNodes() < null_node && "Too many nodes for a compact graph");
+        nodes.reserve(graph.numNodes());
+        nodeIds.reserve(graph.numNodes());
+        for (auto& node : graph) {
+            nodeIds.emplace(node.get(), node_descriptor(nodes.size()));
+            nodes.push_back(node.get());
+        }
+
+        offsets.reserve(nodes.size() + 1);
+        offsets.push_back(0);
+        for (auto* node : nodes) {
+            for (auto& edge : *node) {
+                if (edgePredicate(*edge)) {
+                    targets.push_back(getNodeId(edge->getTargetNode()));
+                    edges.push_back(edge.get());
+                }
+            }
+            offsets.push_back(targets.size());
+        }
+    }
+
+    /// Given a node descriptor, return the node by reference.
+    NodeType& getNode(node_descriptor node) const {
+        SLANG_ASSERT(node < nodes.size() && "Node does not exist");
+        return *nodes[node];
+    }
+
+    /// Return the descriptor of the specified node.
+    node_descriptor getNodeId(const NodeType& node) const {
+        auto it = nodeIds.find(&node);
+        SLANG_ASSERT(it != nodeIds.end() && "Could not find node");
+        return it->second;
+    }
+
+    /// Return the descriptors of the target nodes of the edges outgoing
+    /// from the specified node.
+    std::span<const node_descriptor> getSuccessors(node_descriptor node) const {
+        SLANG_ASSERT(node < nodes.size() && "Node does not exist");
+        return std::span(targets).subspan(offsets[node], offsets[node + 1] - offsets[node]);
+    }
+
+    /// Return the edges outgoing from the specified node, in the same order
+    /// as the nodes returned by @a getSuccessors.
+    std::span<EdgeType* const> getEdges(node_descriptor node) const {
+        SLANG_ASSERT(node < nodes.size() && "Node does not exist");
+        return std::span(edges).subspan(offsets[node], offsets[node + 1] - offsets[node]);
+    }
+
+    /// Return the number of nodes in the snapshot.
+    size_t numNodes() const { return nodes.size(); }
+
+    /// Return the number of edges in the snapshot.
+    size_t numEdges() const { return targets.size(); }
+
+private:
+    std::vector<NodeType*> nodes;
+    slang::flat_hash_map<const NodeType*, node_descriptor> nodeIds;
+
+    // The edges of node i occupy [offsets[i], offsets[i + 1]) in the
+    // targets and edges arrays.
+    std::vector<size_t> offsets;
+    std::vector<node_descriptor> targets;
+    std::vector<EdgeType*> edges;
+};
+
 } // namespace netlist
@@ -12,7 +12,9 @@
 #include "DirectedGraph.h"
 #include "fmt/color.h"
 #include "fmt/format.h"
+#include <atomic>
 #include <iostream>
+#include <optional>
 #include <utility>
 
 #include "slang/ast/ASTVisitor.h"
@@ -26,6 +28,7 @@
 #include "slang/numeric/SVInt.h"
 #include "slang/syntax/SyntaxTree.h"
 #include "slang/syntax/SyntaxVisitor.h"
+#include "slang/util/Hash.h"
 #include "slang/util/Util.h"
 
 using namespace slang;
@@ -259,7 +262,8 @@ public:
     bool blocked{};
 
 private:
-    static size_t nextID;
+    friend class Netlist;
+    static std::atomic<size_t> nextID;
 };
 
 /// A class representing a port declaration.
@@ -360,16 +364,26 @@ public:
 /// A class representing the design netlist.
 class Netlist : public DirectedGraph<NetlistNode, NetlistEdge> {
 public:
+    using CompactGraphType = CompactGraph<NetlistNode, NetlistEdge>;
+
     Netlist() : DirectedGraph() {}
 
+    /// Create a netlist fragment that holds the nodes and edges built for part of
+    /// the design, to be merged back into @a parent with mergeFragment(). Lookups
+    /// of declarations fall through to the parent, and edges from the parent's
+    /// nodes are only added to the graph when the fragment is merged, so several
+    /// fragments of the same parent can be built concurrently.
+    explicit Netlist(Netlist* parent) : DirectedGraph(), parent(parent) {}
+
     /// Add a port declaration node to the netlist.
     NetlistPortDeclaration& addPortDeclaration(const ast::Symbol& symbol) {
         auto nodePtr = std::make_unique<NetlistPortDeclaration>(symbol);
         auto& node = nodePtr->as<NetlistPortDeclaration>();
         symbol.getHierarchicalPath(node.hierarchicalPath);
-        SLANG_ASSERT(lookupPort(nodePtr->hierarchicalPath) == nullptr &&
-                     "Port declaration already exists");
-        nodes.push_back(std::move(nodePtr));
+        [[maybe_unused]] auto [it, inserted] = portIndex.try_emplace(node.hierarchicalPath,
+                                                                     &node);
+        SLANG_ASSERT(inserted && "Port declaration already exists");
+        addOwnedNode(std::move(nodePtr));
         DEBUG_PRINT("New node: port declaration {}\n", node.hierarchicalPath);
         return node;
     }
@@ -385,7 +399,8 @@ public:
             auto nodePtr = std::make_unique<NetlistVariableDeclaration>(symbol);
             nodePtr->hierarchicalPath = hierPath;
             auto& node = nodePtr->as<NetlistVariableDeclaration>();
-            nodes.push_back(std::move(nodePtr));
+            variableIndex.emplace(node.hierarchicalPath, &node);
+            addOwnedNode(std::move(nodePtr));
             DEBUG_PRINT("Add var decl {}\n", node.hierarchicalPath);
             return node;
         }
@@ -396,62 +411,118 @@ public:
         auto nodePtr = std::make_unique<NetlistVariableAlias>(symbol);
         auto& node = nodePtr->as<NetlistVariableAlias>();
         symbol.getHierarchicalPath(node.hierarchicalPath);
-        nodes.push_back(std::move(nodePtr));
+        addOwnedNode(std::move(nodePtr));
         DEBUG_PRINT("New node: variable alias {}\n", node.hierarchicalPath);
         return node;
     }
 
-    /// Add a variable reference node to the netlist.
-    NetlistVariableReference& addVariableReference(const ast::Symbol& symbol,
-                                                   const ast::Expression& expr, bool leftOperand) {
-        auto nodePtr = std::make_unique<NetlistVariableReference>(symbol, expr, leftOperand);
-        auto& node = nodePtr->as<NetlistVariableReference>();
-        nodes.push_back(std::move(nodePtr));
-        DEBUG_PRINT("New node: variable reference {}\n", symbol.name);
+    /// Add a variable reference node to the netlist. The node is indexed by its
+    /// syntax, so it must be complete (ie have all of its selectors) by now.
+    NetlistVariableReference& addVariableReference(
+        std::unique_ptr<NetlistVariableReference> nodePtr) {
+        auto& node = *nodePtr;
+        referenceIndex.try_emplace(node.toString(), &node);
+        addOwnedNode(std::move(nodePtr));
+        DEBUG_PRINT("New node: variable reference {}\n", node.symbol.name);
         return node;
     }
 
-    // without this, the base class method will be hidden,
-    // even when calling netlist.addEdge with only 2 parameters
-    using DirectedGraph<NetlistNode, NetlistEdge>::addEdge;
+    /// Add an edge between two existing nodes in the netlist. In a fragment, an
+    /// edge from one of the parent's nodes is deferred until the fragment is merged.
+    void addEdge(NetlistNode& sourceNode, NetlistNode& targetNode) {
+        compactGraph.reset();
+        if (!parent) {
+            DirectedGraph<NetlistNode, NetlistEdge>::addEdge(sourceNode, targetNode);
+        }
+        else if (ownedNodes.contains(&sourceNode)) {
+            // Only the source node is modified, so the target can be one of the parent's.
+            sourceNode.addEdge(targetNode);
+        }
+        else {
+            deferredEdges.emplace_back(&sourceNode, &targetNode, std::nullopt);
+        }
+    }
 
-    NetlistEdge& addEdge(NetlistNode& sourceNode, NetlistNode& targetNode, ast::EdgeKind edgeKind) {
-        auto& edge = DirectedGraph<NetlistNode, NetlistEdge>::addEdge(sourceNode, targetNode);
+    void addEdge(NetlistNode& sourceNode, NetlistNode& targetNode, ast::EdgeKind edgeKind) {
+        if (parent && !ownedNodes.contains(&targetNode)) {
+            deferredEdges.emplace_back(&sourceNode, &targetNode, edgeKind);
+            return;
+        }
+        addEdge(sourceNode, targetNode);
         targetNode.edgeKind = edgeKind;
-        return edge;
+    }
+
+    /// Move the nodes and edges of a fragment created from this netlist into it.
+    /// Fragments should be merged in the same order each time so that the
+    /// resulting node and edge order is deterministic.
+    void mergeFragment(Netlist& fragment) {
+        SLANG_ASSERT(fragment.parent == this);
+        compactGraph.reset();
+        for (auto& node : fragment.nodes) {
+            // Renumber the node, since fragments are built concurrently.
+            node->ID = ++NetlistNode::nextID;
+            if (node->kind == NodeKind::VariableDeclaration) {
+                auto& varDecl = node->as<NetlistVariableDeclaration>();
+                variableIndex.try_emplace(varDecl.hierarchicalPath, &varDecl);
+            }
+            nodes.push_back(std::move(node));
+        }
+
+        // The fragment's index holds the first of its references with each syntax,
+        // which is the one to use here unless this netlist already has one.
+        for (auto& [syntax, node] : fragment.referenceIndex)
+            referenceIndex.try_emplace(syntax, node);
+
+        for (auto& [sourceNode, targetNode, edgeKind] : fragment.deferredEdges) {
+            if (edgeKind)
+                addEdge(*sourceNode, *targetNode, *edgeKind);
+            else
+                addEdge(*sourceNode, *targetNode);
+        }
+
+        fragment.nodes.clear();
+        fragment.deferredEdges.clear();
+        fragment.ownedNodes.clear();
+        fragment.variableIndex.clear();
+        fragment.referenceIndex.clear();
+    }
+
+    /// Return a compact snapshot of the netlist graph for fast traversal,
+    /// excluding disabled edges. The snapshot is built on first use and kept
+    /// until the netlist is next modified, so it should be requested after
+    /// the netlist is complete (ie after calling split()).
+    const CompactGraphType& getCompactGraph() {
+        if (!compactGraph) {
+            compactGraph = std::make_unique<CompactGraphType>(
+                *this, [](const NetlistEdge& edge) { return !edge.disabled; });
+        }
+        return *compactGraph;
     }
 
     /// Find a port declaration node in the netlist by hierarchical path.
     NetlistPortDeclaration* lookupPort(std::string_view hierarchicalPath) {
-        auto compareNode = [&hierarchicalPath](const std::unique_ptr<NetlistNode>& node) {
-            return node->kind == NodeKind::PortDeclaration &&
-                   node->as<NetlistPortDeclaration>().hierarchicalPath == hierarchicalPath;
-        };
-        auto it = std::ranges::find_if(*this, compareNode);
-        return it != end() ? &it->get()->as<NetlistPortDeclaration>() : nullptr;
+        auto it = portIndex.find(hierarchicalPath);
+        if (it != portIndex.end())
+            return it->second;
+        return parent ? parent->lookupPort(hierarchicalPath) : nullptr;
     }
 
     /// Find a variable declaration node in the netlist by hierarchical path.
     /// Note that this does not lookup alias nodes.
     NetlistVariableDeclaration* lookupVariable(std::string_view hierarchicalPath) {
-        auto compareNode = [&hierarchicalPath](const std::unique_ptr<NetlistNode>& node) {
-            return node->kind == NodeKind::VariableDeclaration &&
-                   node->as<NetlistVariableDeclaration>().hierarchicalPath == hierarchicalPath;
-        };
-        auto it = std::ranges::find_if(*this, compareNode);
-        return it != end() ? &it->get()->as<NetlistVariableDeclaration>() : nullptr;
+        auto it = variableIndex.find(hierarchicalPath);
+        if (it != variableIndex.end())
+            return it->second;
+        return parent ? parent->lookupVariable(hierarchicalPath) : nullptr;
     }
 
     /// Find a variable reference node in the netlist by its syntax.
     /// Note that this does not include the hierarchical path, which is only
     /// associated with the corresponding variable declaration nodes.
+    /// If several references have the same syntax, the first one added is returned.
     NetlistVariableReference* lookupVariableReference(std::string_view syntax) {
-        auto compareNode = [&syntax](const std::unique_ptr<NetlistNode>& node) {
-            return node->kind == NodeKind::VariableReference &&
-                   node->as<NetlistVariableReference>().toString() == syntax;
-        };
-        auto it = std::ranges::find_if(*this, compareNode);
-        return it != end() ? &it->get()->as<NetlistVariableReference>() : nullptr;
+        auto it = referenceIndex.find(syntax);
+        return it != referenceIndex.end() ? it->second : nullptr;
     }
 
     /// Perform a transformation on the netlist graph to split variable /
@@ -499,6 +570,7 @@ public:
             }
         }
         // Apply the operations to the graph.
+        compactGraph.reset();
         for (auto& modification : modifications) {
             auto* varDeclNode = std::get<0>(modification);
             auto* inEdge = std::get<1>(modification);
@@ -513,6 +585,79 @@ public:
             varAliasNode.addEdge(outEdge->getTargetNode());
         }
     }
+
+protected:
+    /// Remove the specified node from the indexes before it is removed from
+    /// the netlist.
+    void onRemoveNode(NetlistNode& nodeToRemove) override {
+        compactGraph.reset();
+        switch (nodeToRemove.kind) {
+            case NodeKind::PortDeclaration:
+                portIndex.erase(nodeToRemove.as<NetlistPortDeclaration>().hierarchicalPath);
+                break;
+            case NodeKind::VariableDeclaration:
+                variableIndex.erase(
+                    nodeToRemove.as<NetlistVariableDeclaration>().hierarchicalPath);
+                break;
+            case NodeKind::VariableReference: {
+                auto syntax = nodeToRemove.as<NetlistVariableReference>().toString();
+                auto it = referenceIndex.find(syntax);
+                if (it == referenceIndex.end() || it->second != &nodeToRemove)
+                    break;
+
+                // Another reference may have the same syntax as the removed one,
+                // in which case the next one that was added takes its place.
+                referenceIndex.erase(it);
+                for (auto& node : nodes) {
+                    if (node->kind == NodeKind::VariableReference && node.get() != &nodeToRemove) {
+                        auto& ref = node->as<NetlistVariableReference>();
+                        if (ref.toString() == syntax) {
+                            referenceIndex.emplace(std::move(syntax), &ref);
+                            break;
+                        }
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+private:
+    void addOwnedNode(std::unique_ptr<NetlistNode> nodePtr) {
+        if (parent)
+            ownedNodes.insert(nodePtr.get());
+        compactGraph.reset();
+        nodes.push_back(std::move(nodePtr));
+    }
+
+    // Indexes for looking up nodes, keyed by strings owned by the nodes themselves.
+    flat_hash_map<std::string_view, NetlistPortDeclaration*> portIndex;
+    flat_hash_map<std::string_view, NetlistVariableDeclaration*> variableIndex;
+
+    // Allows looking up strings by string_view without making a copy.
+    struct StringHash {
+        using is_transparent = void;
+        using is_avalanching = void;
+        uint64_t operator()(std::string_view str) const noexcept {
+            return slang::hash<std::string_view>()(str);
+        }
+    };
+
+    // Variable references keyed by their syntax.
+    flat_hash_map<std::string, NetlistVariableReference*, StringHash, std::equal_to<>>
+        referenceIndex;
+
+    // A snapshot of the graph, built on demand.
+    std::unique_ptr<CompactGraphType> compactGraph;
+
+    // For a fragment, the netlist it will be merged into, the nodes the fragment
+    // created itself, and the edges to add once it has been merged.
+    Netlist* parent = nullptr;
+    flat_hash_set<const NetlistNode*> ownedNodes;
+    std::vector<std::tuple<NetlistNode*, NetlistNode*, std::optional<ast::EdgeKind>>>
+        deferredEdges;
 };
 
 } // namespace netlist
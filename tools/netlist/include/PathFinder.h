@@ -10,7 +10,6 @@
 #include "DepthFirstSearch.h"
 #include "Netlist.h"
 #include "NetlistPath.h"
-#include <map>
 #include <vector>
 
 #include "slang/util/Util.h"
@@ -20,27 +19,28 @@ namespace netlist {
 /// Find a path between two points in a netlist.
 class PathFinder {
 private:
+    using CompactGraphType = Netlist::CompactGraphType;
+    using node_descriptor = CompactGraphType::node_descriptor;
+
     /// Depth-first traversal produces a tree sub graph and as such, each node
-    /// can only have one parent node. This map captures these relationships and
-    /// is used to determine paths between leaf nodes and the root node of the
-    /// tree.
-    using TraversalMap = std::map<NetlistNode*, NetlistNode*>;
+    /// can only have one parent node. This map, indexed by the node descriptors
+    /// of the netlist's compact graph, captures these relationships and is used
+    /// to determine paths between leaf nodes and the root node of the tree.
+    using TraversalMap = std::vector<node_descriptor>;
 
     /// A visitor for the search that constructs the traversal map.
     class Visitor {
     public:
-        Visitor(Netlist& netlist, TraversalMap& traversalMap) :
-            netlist(netlist), traversalMap(traversalMap) {}
+        Visitor(TraversalMap& traversalMap) : traversalMap(traversalMap) {}
         void visitNode(NetlistNode& node) {}
-        void visitEdge(NetlistEdge& edge) {
-            auto* sourceNode = &edge.getSourceNode();
-            auto* targetNode = &edge.getTargetNode();
-            SLANG_ASSERT(traversalMap.count(targetNode) == 0 && "node cannot have two parents");
+        void visitEdge(NetlistEdge& edge, node_descriptor sourceNode,
+                       node_descriptor targetNode) {
+            SLANG_ASSERT(traversalMap[targetNode] == CompactGraphType::null_node &&
+                         "node cannot have two parents");
             traversalMap[targetNode] = sourceNode;
         }
 
     private:
-        Netlist& netlist;
         TraversalMap& traversalMap;
     };
 
@@ -53,26 +53,29 @@ private:
 public:
     PathFinder(Netlist& netlist) : netlist(netlist) {}
 
-    NetlistPath buildPath(TraversalMap& traversalMap, NetlistNode& startNode,
-                          NetlistNode& endNode) {
+    NetlistPath buildPath(const CompactGraphType& graph, TraversalMap& traversalMap,
+                          NetlistNode& startNode, NetlistNode& endNode) {
+        auto start = graph.getNodeId(startNode);
+        auto end = graph.getNodeId(endNode);
         // Empty path.
-        if (traversalMap.count(&endNode) == 0) {
+        if (traversalMap[end] == CompactGraphType::null_node) {
             return NetlistPath();
         }
         // Single-node path.
-        if (startNode == endNode) {
+        if (start == end) {
             return NetlistPath({&endNode});
         }
         // Multi-node path.
         NetlistPath path;
-        auto* nextNode = &endNode;
+        auto nextNode = end;
         do {
             nextNode = traversalMap[nextNode];
             // Add only the variable references to the path.
-            if (nextNode->kind == NodeKind::VariableReference) {
-                path.add(*nextNode);
+            auto& node = graph.getNode(nextNode);
+            if (node.kind == NodeKind::VariableReference) {
+                path.add(node);
             }
-        } while (nextNode != &startNode);
+        } while (nextNode != start);
         path.reverse();
         return path;
     }
@@ -80,10 +83,12 @@ public:
     /// Find a path between two nodes in the netlist.
     /// Return a NetlistPath object that is empty if the path does not exist.
     NetlistPath find(NetlistNode& startNode, NetlistNode& endNode) {
-        TraversalMap traversalMap;
-        Visitor visitor(netlist, traversalMap);
-        DepthFirstSearch<NetlistNode, NetlistEdge, Visitor, EdgePredicate> dfs(visitor, startNode);
-        return buildPath(traversalMap, startNode, endNode);
+        auto& graph = netlist.getCompactGraph();
+        TraversalMap traversalMap(graph.numNodes(), CompactGraphType::null_node);
+        Visitor visitor(traversalMap);
+        DepthFirstSearch<NetlistNode, NetlistEdge, Visitor, EdgePredicate> dfs(visitor, graph,
+                                                                                startNode);
+        return buildPath(graph, traversalMap, startNode, endNode);
     }
 
 private:
@@ -18,8 +18,11 @@ namespace netlist {
 /// marked as uninstantiated, and are therefore not visited.
 class GenerateBlockVisitor : public ast::ASTVisitor<GenerateBlockVisitor, true, false> {
 public:
-    explicit GenerateBlockVisitor(ast::Compilation& compilation, Netlist& netlist) :
-        compilation(compilation), netlist(netlist) {}
+    /// If @a declarationsOnly is set, only the variable and net declarations
+    /// in the block are added to the netlist.
+    explicit GenerateBlockVisitor(ast::Compilation& compilation, Netlist& netlist,
+                                  bool declarationsOnly = false) :
+        netlist(netlist), compilation(compilation), declarationsOnly(declarationsOnly) {}
 
     /// Variable declaration.
     void handle(const ast::VariableSymbol& symbol) { netlist.addVariableDeclaration(symbol); }
@@ -29,12 +32,18 @@ public:
 
     /// Procedural block.
     void handle(const ast::ProceduralBlockSymbol& symbol) {
+        if (declarationsOnly)
+            return;
+
         ProceduralBlockVisitor visitor(compilation, netlist, ast::EdgeKind::None);
         symbol.visit(visitor);
     }
 
     /// Continuous assignment statement.
     void handle(const ast::ContinuousAssignSymbol& symbol) {
+        if (declarationsOnly)
+            return;
+
         ast::EvalContext evalCtx(ast::ASTContext(compilation.getRoot(), ast::LookupLocation::max));
         SmallVector<NetlistNode*> condVars;
         ContinuousAssignVisitor visitor(netlist, evalCtx, condVars);
@@ -44,6 +53,7 @@ public:
 private:
     Netlist& netlist;
     ast::Compilation& compilation;
+    bool declarationsOnly;
 };
 
 } // namespace netlist
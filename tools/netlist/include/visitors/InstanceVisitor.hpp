@@ -22,6 +22,13 @@ public:
     explicit InstanceVisitor(ast::Compilation& compilation, Netlist& netlist) :
         compilation(compilation), netlist(netlist) {}
 
+    /// Construct a visitor that only creates the port and variable declarations
+    /// of each instance, appending the instances to @a instances so that their
+    /// bodies can be built separately with buildInstanceBody().
+    explicit InstanceVisitor(ast::Compilation& compilation, Netlist& netlist,
+                             std::vector<const ast::InstanceSymbol*>& instances) :
+        compilation(compilation), netlist(netlist), instances(&instances) {}
+
 private:
     void connectDeclToVar(NetlistNode& declNode, const ast::Symbol& variable) {
         auto* varNode = netlist.lookupVariable(resolveSymbolHierPath(variable));
@@ -178,6 +185,15 @@ private:
     }
 
 public:
+    /// Connect the ports of an instance whose declarations have already been
+    /// created, and build the contents of its body, except for the instances
+    /// nested inside it.
+    void buildInstanceBody(const ast::InstanceSymbol& symbol) {
+        skipNestedInstances = true;
+        handleInstanceExtPorts(symbol);
+        symbol.body.visit(*this);
+    }
+
     /// Variable declaration (deferred to handleInstanceMemberVars).
     void handle(const ast::VariableSymbol& symbol) {}
 
@@ -189,6 +205,9 @@ public:
 
     /// Instance.
     void handle(const ast::InstanceSymbol& symbol) {
+        if (skipNestedInstances)
+            return;
+
         DEBUG_PRINT("Instance: {}\n", getSymbolHierPath(symbol));
 
         if (getSymbolHierPath(symbol) == "$unit") {
@@ -200,13 +219,19 @@ public:
 
         handleInstanceMemberVars(symbol);
         handleInstanceMemberPorts(symbol);
-        handleInstanceExtPorts(symbol);
+        if (instances)
+            instances->push_back(&symbol);
+        else
+            handleInstanceExtPorts(symbol);
 
         symbol.body.visit(*this);
     }
 
     /// Procedural block.
     void handle(const ast::ProceduralBlockSymbol& symbol) {
+        if (instances)
+            return;
+
         ProceduralBlockVisitor visitor(compilation, netlist,
                                        ProceduralBlockVisitor::determineEdgeKind(symbol));
         symbol.visit(visitor);
@@ -215,13 +240,16 @@ public:
     /// Generate block.
     void handle(const ast::GenerateBlockSymbol& symbol) {
         if (!symbol.isUninstantiated) {
-            GenerateBlockVisitor visitor(compilation, netlist);
+            GenerateBlockVisitor visitor(compilation, netlist, instances != nullptr);
             symbol.visit(visitor);
         }
     }
 
     /// Continuous assignment statement.
     void handle(const ast::ContinuousAssignSymbol& symbol) {
+        if (instances)
+            return;
+
         ast::EvalContext evalCtx(ast::ASTContext(compilation.getRoot(), ast::LookupLocation::max));
         SmallVector<NetlistNode*> condVars;
         ContinuousAssignVisitor visitor(netlist, evalCtx, condVars);
@@ -231,6 +259,8 @@ public:
 private:
     ast::Compilation& compilation;
     Netlist& netlist;
+    std::vector<const ast::InstanceSymbol*>* instances = nullptr;
+    bool skipNestedInstances = false;
 };
 
 } // namespace netlist
@@ -26,6 +26,7 @@
 #include "slang/ast/symbols/CompilationUnitSymbols.h"
 #include "slang/ast/symbols/ValueSymbol.h"
 #include "slang/diagnostics/TextDiagnosticClient.h"
+#include "slang/util/ThreadPool.h"
 #include "slang/util/Util.h"
 
 using namespace slang;
@@ -35,17 +36,49 @@ namespace netlist {
 /// The top-level visitor that traverses the AST and builds a netlist connectivity graph.
 class NetlistVisitor : public ast::ASTVisitor<NetlistVisitor, true, false> {
 public:
-    explicit NetlistVisitor(ast::Compilation& compilation, Netlist& netlist) :
-        compilation(compilation), netlist(netlist) {}
+    /// If @a numThreads is anything other than one, the netlist for each top-level
+    /// instance is built in two passes: the port and variable declarations of every
+    /// instance in its hierarchy are created first, and then the bodies of those
+    /// instances are built independently as netlist fragments on a thread pool with
+    /// that many threads (or one per hardware thread, if zero). The fragments are
+    /// merged in hierarchy order, connecting them to each other at the declarations
+    /// they share, so the result is the same each time. The compilation must have
+    /// been fully elaborated (eg by requesting all of its diagnostics) beforehand.
+    explicit NetlistVisitor(ast::Compilation& compilation, Netlist& netlist,
+                            unsigned numThreads = 1) :
+        compilation(compilation), netlist(netlist), numThreads(numThreads) {}
 
     void handle(const ast::InstanceSymbol& symbol) {
-        InstanceVisitor visitor(compilation, netlist);
+        if (numThreads == 1) {
+            InstanceVisitor visitor(compilation, netlist);
+            symbol.visit(visitor);
+            return;
+        }
+
+        std::vector<const ast::InstanceSymbol*> instances;
+        InstanceVisitor visitor(compilation, netlist, instances);
         symbol.visit(visitor);
+
+        std::vector<std::unique_ptr<Netlist>> fragments(instances.size());
+        ThreadPool threadPool(numThreads);
+        threadPool.pushLoop(size_t(0), instances.size(), [&](size_t start, size_t end) {
+            for (size_t i = start; i < end; i++) {
+                auto fragment = std::make_unique<Netlist>(&netlist);
+                InstanceVisitor bodyVisitor(compilation, *fragment);
+                bodyVisitor.buildInstanceBody(*instances[i]);
+                fragments[i] = std::move(fragment);
+            }
+        });
+        threadPool.waitForAll();
+
+        for (auto& fragment : fragments)
+            netlist.mergeFragment(*fragment);
     }
 
 private:
     ast::Compilation& compilation;
     Netlist& netlist;
+    unsigned numThreads;
 };
 
 } // namespace netlist
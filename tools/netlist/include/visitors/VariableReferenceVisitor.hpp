@@ -27,9 +27,9 @@ public:
             return;
         }
 
-        // Add the variable reference to the netlist.
-        auto& node = netlist.addVariableReference(expr.symbol, expr, leftOperand);
-        varList.push_back(&node);
+        // Build the variable reference, which is added to the netlist once complete.
+        auto nodePtr = std::make_unique<NetlistVariableReference>(expr.symbol, expr, leftOperand);
+        auto& node = *nodePtr;
         for (auto* selector : selectors) {
             if (selector->kind == ast::ExpressionKind::ElementSelect) {
                 const auto& expr = selector->as<ast::ElementSelectExpression>();
@@ -68,6 +68,9 @@ public:
         DEBUG_PRINT("Variable reference: {} bounds [{}:{}]\n", node.toString(), node.bounds.lower(),
                     node.bounds.upper());
 
+        netlist.addVariableReference(std::move(nodePtr));
+        varList.push_back(&node);
+
         // Clear the selectors for the next named value.
         selectors.clear();
     }
@@ -143,6 +143,24 @@ void reportPath(Compilation& compilation, const NetlistPath& path) {
     }
 }
 
+void reportComponents(Netlist& netlist, const std::vector<std::vector<ID_type>>& components) {
+    // Every combinatorial loop lies within one of these components, so they
+    // can be reported before the (potentially slow) search for the loops.
+    if (components.empty())
+        return;
+
+    OS::print(fmt::format("Found {} strongly connected component{} with possible "
+                          "combinatorial loops:\n",
+                          components.size(), components.size() > 1 ? "s" : ""));
+    std::string buffer;
+    for (auto& nodes : components) {
+        auto& node = netlist.getNode(nodes.front());
+        buffer.clear();
+        node.symbol.getHierarchicalPath(buffer);
+        OS::print(fmt::format("  {} nodes, including {}\n", nodes.size(), buffer));
+    }
+}
+
 void dumpCyclesList(Compilation& compilation, Netlist& netlist,
                     std::vector<CycleListType>* cycles) {
     auto s = cycles->size();
@@ -183,6 +201,17 @@ int main(int argc, char** argv) {
     driver.cmdLine.add("-d,--debug", debug, "Output debugging information");
     driver.cmdLine.add("-c,--comb-loops", combLoops, "Detect combinatorial loops");
 
+    std::optional<bool> parallelBuild;
+    driver.cmdLine.add("--parallel-build", parallelBuild,
+                       "Build the netlist for each instance in parallel, using the number of "
+                       "threads set by --threads");
+
+    std::optional<uint32_t> combLoopsLimit;
+    driver.cmdLine.add("--comb-loops-limit", combLoopsLimit,
+                       "Stop detecting combinatorial loops in a strongly connected component "
+                       "after the given number have been found in it",
+                       "<count>");
+
     std::optional<std::string> astJsonFile;
     driver.cmdLine.add(
         "--ast-json", astJsonFile,
@@ -254,7 +283,8 @@ int main(int argc, char** argv) {
 
         // Create the netlist by traversing the AST.
         Netlist netlist;
-        NetlistVisitor visitor(*compilation, netlist);
+        NetlistVisitor visitor(*compilation, netlist,
+                               parallelBuild == true ? driver.options.numThreads.value_or(0) : 1);
         compilation->getRoot().visit(visitor);
         netlist.split();
         DEBUG_PRINT("Netlist has {} nodes and {} edges\n", netlist.numNodes(), netlist.numEdges());
@@ -267,7 +297,17 @@ int main(int argc, char** argv) {
 
         if (combLoops == true) {
             ElementaryCyclesSearch ecs(netlist);
-            std::vector<CycleListType>* cycles = ecs.getElementaryCycles();
+            auto& components = ecs.getStronglyConnectedComponents();
+            reportComponents(netlist, components);
+
+            std::vector<CycleListType>* cycles = ecs.getElementaryCycles(
+                combLoopsLimit.value_or(0), driver.options.numThreads.value_or(0));
+            for (auto index : ecs.getTruncatedComponents()) {
+                OS::print(fmt::format("Stopped after {} combinatorial loop{} in the strongly "
+                                      "connected component with {} nodes\n",
+                                      *combLoopsLimit, *combLoopsLimit > 1 ? "s" : "",
+                                      components[index].size()));
+            }
             dumpCyclesList(*compilation, netlist, cycles);
         }
         // Find a point-to-point path in the netlist.
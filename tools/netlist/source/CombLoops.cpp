@@ -31,274 +31,365 @@
 #include "CombLoops.h"
 
 #include "NetlistPath.h"
+#include <span>
 
 #include "slang/ast/SemanticFacts.h"
+#include "slang/util/ThreadPool.h"
 
-/**
- * This is a helpclass for the search of all elementary cycles in a graph
- * with the algorithm of Johnson. For this it searches for strong connected
- * components, using the algorithm of Tarjan. The constructor gets an
- * adjacency-list of a graph. Based on this graph, it gets a nodenumber s,
- * for which it calculates the subgraph, containing all nodes
- * {s, s + 1, ..., n}, where n is the highest nodenumber in the original
- * graph (e.g. it builds a subgraph with all nodes with higher or same
- * nodenumbers like the given node s). It returns the strong connected
- * component of this subgraph which contains the lowest nodenumber of all
- * nodes in the subgraph.<br><br>
- *
- * For a description of the algorithm for calculating the strong connected
- * components see:<br>
- * Robert Tarjan: Depth-first search and linear graph algorithms. In: SIAM
- * Journal on Computing. Volume 1, Nr. 2 (1972), pp. 146-160.<br>
- * For a description of the algorithm for searching all elementary cycles in
- * a directed graph see:<br>
- * Donald B. Johnson: Finding All the Elementary Circuits of a Directed Graph.
- * SIAM Journal on Computing. Volumne 4, Nr. 1 (1975), pp. 77-84.<br><br>
- *
- * @author Frank Meyer, web_at_normalisiert_dot_de
- * @version 1.1, 22.03.2009
- *
- */
-
-SCCResult StrongConnectedComponents::sccr_dummy;
+namespace {
 
 /**
- * This method returns the adjacency-structure of the strong connected
- * component with the least vertex in a subgraph of the original graph
- * induced by the nodes {s, s + 1, ..., n}, where s is a given node. Note
- * that trivial strong connected components with just one node will not
- * be returned.
- *
- * @param node node s
- * @return SCCResult with adjacency-structure of the strong
- * connected component; null, if no such component exists
+ * Finds strongly connected components using an iterative form of the
+ * algorithm of Tarjan, so that long paths through the graph can't overflow
+ * the call stack. The state can be reused for several searches over the
+ * same set of nodes by calling reset() in between.
  */
-SCCResult& StrongConnectedComponents::getAdjacencyList(int node) {
-    auto adjListOriginal_s = adjListOriginal.size();
-    lowlink.resize(adjListOriginal_s);
-    number.resize(adjListOriginal_s);
-    visited.resize(adjListOriginal_s);
-
-    while (true) {
-        std::fill(visited.begin(), visited.end(), false);
-        stack.clear();
-        currentSCCs.clear();
-
-        makeAdjListSubgraph(node);
-        for (int i = node; i < adjListOriginal_s; i++) {
-            if (!visited[i]) {
-                getStrongConnectedComponents(i);
-                const std::vector<int>* nodes = getLowestIdComponent();
-                if (nodes != nullptr && !nodes->empty() && !find_vec(*nodes, node) &&
-                    !find_vec(*nodes, node + 1)) {
-                    node++;
+class TarjanSearch {
+public:
+    explicit TarjanSearch(size_t numNodes) :
+        index(numNodes, Unvisited), lowlink(numNodes), onStack(numNodes) {}
+
+    /**
+     * Searches the nodes reachable from root that haven't been visited yet,
+     * following only edges to nodes accepted by the include predicate, and
+     * calls onComponent with the root and nodes of each component found.
+     */
+    template<typename TInclude, typename TCallback>
+    void run(ID_type root, const std::vector<std::vector<ID_type>>& adjList, TInclude&& include,
+             TCallback&& onComponent) {
+        if (index[root] != Unvisited)
+            return;
+
+        visit(root);
+        while (!frames.empty()) {
+            auto& frame = frames.back();
+            auto v = frame.node;
+            auto& succs = adjList[v];
+            if (frame.next < succs.size()) {
+                auto w = succs[frame.next++];
+                if (!include(w))
                     continue;
-                }
-                else if (nodes != nullptr) {
-                    buildAdjList(*nodes, sccr_current);
-                    auto& adjacencyList = sccr_current.getAdjListForWrite();
-                    if (!adjacencyList.empty()) {
-                        for (int j = 0; j < adjListOriginal_s; j++) {
-                            if (!adjacencyList[j].empty()) {
-                                sccr_current.setLowestNodeId(j);
-                                return sccr_current;
-                            }
-                        }
-                    }
-                }
+                if (index[w] == Unvisited)
+                    visit(w);
+                else if (onStack[w])
+                    lowlink[v] = std::min(lowlink[v], index[w]);
+                continue;
+            }
+
+            frames.pop_back();
+            if (!frames.empty()) {
+                auto parent = frames.back().node;
+                lowlink[parent] = std::min(lowlink[parent], lowlink[v]);
+            }
+
+            if (lowlink[v] == index[v]) {
+                component.clear();
+                ID_type w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = false;
+                    component.push_back(w);
+                } while (w != v);
+                onComponent(v, std::span<const ID_type>(component));
             }
         }
-        return sccr_dummy;
     }
-}
+
+    /** Marks all nodes as unvisited again. */
+    void reset() {
+        std::ranges::fill(index, Unvisited);
+        counter = 0;
+    }
+
+private:
+    static constexpr int Unvisited = -1;
+
+    struct Frame {
+        ID_type node;
+        size_t next;
+    };
+
+    void visit(ID_type node) {
+        index[node] = lowlink[node] = counter++;
+        stack.push_back(node);
+        onStack[node] = true;
+        frames.push_back({node, 0});
+    }
+
+    std::vector<int> index;
+    std::vector<int> lowlink;
+    std::vector<bool> onStack;
+    std::vector<ID_type> stack;
+    std::vector<Frame> frames;
+    std::vector<ID_type> component;
+    int counter = 0;
+};
 
 /**
- * Builds the adjacency-list for a subgraph containing just nodes
- * >= a given index.
- *
- * @param node Node with lowest index in the subgraph
+ * Searches a single strongly connected component for elementary cycles
+ * with the algorithm of Johnson. The nodes of the component are numbered
+ * locally, in the same order as their IDs in the full graph, so that all of
+ * the search state is proportional to the size of the component.
  */
-void StrongConnectedComponents::makeAdjListSubgraph(const int node) {
-    adjList.clear();
-    const int adjListSize = adjListOriginal.size();
-    adjList.resize(adjListSize);
-
-    for (int i = node; i < adjListSize; i++) {
-        const int adjListOriginalISize = adjListOriginal[i].size();
-        for (int j = 0; j < adjListOriginalISize; j++) {
-            const int currentNode = adjListOriginal[i][j];
-            if (currentNode >= node) {
-                adjList[i].push_back(currentNode);
+class ComponentCycleSearch {
+public:
+    ComponentCycleSearch(const std::vector<ID_type>& nodes,
+                         const std::vector<std::vector<ID_type>>& fullAdjList,
+                         const std::vector<ID_type>& localIds) :
+        nodes(nodes), adjList(nodes.size()), blocked(nodes.size()), B(nodes.size()),
+        stamps(nodes.size()), tarjan(nodes.size()) {
+        for (size_t i = 0; i < nodes.size(); i++) {
+            for (auto succ : fullAdjList[nodes[i]]) {
+                auto local = localIds[succ];
+                if (local >= 0 && nodes[local] == succ)
+                    adjList[i].push_back(local);
             }
         }
     }
-}
 
-/**
- * Calculates the strong connected component out of a set of scc's, that
- * contains the node with the lowest index.
- *
- * @return Vector::Integer of the scc containing the lowest nodenumber
- */
-const std::vector<int>* StrongConnectedComponents::getLowestIdComponent() const {
-    int min = adjList.size();
-    const std::vector<int>* currScc = nullptr;
-
-    for (int i = 0; i < currentSCCs.size(); i++) {
-        for (int j = 0; j < currentSCCs[i].size(); j++) {
-            const int node = currentSCCs[i][j];
-            if (node < min) {
-                currScc = &currentSCCs[i];
-                min = node;
+    /**
+     * Finds the cycles in the component, in the same order as a search of the
+     * whole graph would, and appends them to results using full graph IDs.
+     * @return true if the search stopped early because there were more than
+     * maxCycles cycles.
+     */
+    bool run(size_t maxCycles, std::vector<CycleListType>& results) {
+        const auto numNodes = ID_type(nodes.size());
+        for (ID_type s = 0; s < numNodes; s++) {
+            // Find the strong component containing s in the subgraph induced
+            // by s and the nodes that follow it. If that's just s itself, the
+            // only possible cycle through s is a self edge.
+            size_t componentSize = 0;
+            tarjan.reset();
+            tarjan.run(
+                s, adjList, [s](ID_type w) { return w >= s; },
+                [&](ID_type root, std::span<const ID_type> component) {
+                    if (root != s)
+                        return;
+                    componentSize = component.size();
+                    for (auto w : component) {
+                        stamps[w] = s + 1;
+                        blocked[w] = false;
+                        B[w].clear();
+                    }
+                });
+
+            if ((componentSize > 1 || find_vec(adjList[s], s)) &&
+                findCycles(s, maxCycles, results)) {
+                return true;
             }
         }
+        return false;
     }
 
-    return currScc;
-}
+private:
+    struct Frame {
+        ID_type node;
+        size_t next;
+        bool found;
+    };
+
+    bool inComponent(ID_type node, ID_type s) const { return stamps[node] == s + 1; }
+
+    /**
+     * Calculates the cycles through s in its current component. This is the
+     * CIRCUIT procedure from Johnson's paper, using an explicit stack.
+     * @return true if a cycle was found beyond maxCycles.
+     */
+    bool findCycles(ID_type s, size_t maxCycles, std::vector<CycleListType>& results) {
+        blocked[s] = true;
+        path.push_back(s);
+        frames.push_back({s, 0, false});
+
+        while (!frames.empty()) {
+            auto& frame = frames.back();
+            auto v = frame.node;
+            auto& succs = adjList[v];
+            if (frame.next < succs.size()) {
+                auto w = succs[frame.next++];
+                if (!inComponent(w, s))
+                    continue;
 
-/**
- * Fills SCCResult with adjacency list representing the adjacency-structure
- * of the strong connected component with least vertex in the currently
- * viewed subgraph
- */
-void StrongConnectedComponents::buildAdjList(const std::vector<int>& nodes, SCCResult& sccr) const {
-    std::vector<std::vector<int>>& lowestIdAdjacencyList = sccr.getAdjListForWrite();
-    auto nodes_s = nodes.size();
-    lowestIdAdjacencyList.clear();
-    lowestIdAdjacencyList.resize(adjList.size());
-    if (!nodes.empty()) {
-        for (int i = 0; i < nodes_s; i++) {
-            int node = nodes[i];
-            std::vector<int>& sccr_adjlist_node = lowestIdAdjacencyList[node];
-            auto& adjList_node = adjList[node];
-            sccr_adjlist_node.clear();
-            const int ns = adjList_node.size();
-            for (int j = 0; j < ns; j++) {
-                int succ = adjList_node[j];
-                if (find_vec(nodes, succ)) {
-                    sccr_adjlist_node.push_back(succ);
+                if (w == s) {
+                    // Only stop once there is a cycle beyond the limit, so that
+                    // finding exactly maxCycles doesn't count as being truncated.
+                    if (maxCycles && numCycles == maxCycles) {
+                        path.clear();
+                        frames.clear();
+                        return true;
+                    }
+
+                    auto& cycle = results.emplace_back();
+                    for (auto node : path)
+                        cycle.push_back(nodes[node]);
+                    frame.found = true;
+                    numCycles++;
+                }
+                else if (!blocked[w]) {
+                    blocked[w] = true;
+                    path.push_back(w);
+                    frames.push_back({w, 0, false});
+                }
+                continue;
+            }
+
+            bool found = frame.found;
+            if (found) {
+                unblock(v);
+            }
+            else {
+                for (auto w : succs) {
+                    if (inComponent(w, s) && !find_vec(B[w], v))
+                        B[w].push_back(v);
                 }
             }
+
+            path.pop_back();
+            frames.pop_back();
+            if (found && !frames.empty())
+                frames.back().found = true;
         }
+        return false;
     }
-}
 
-/**
- * Searchs for strong connected components reachable from a given node.
- *
- * @param root node to start from.
- */
-void StrongConnectedComponents::getStrongConnectedComponents(int root) {
-    sccCounter++;
-    lowlink[root] = sccCounter;
-    number[root] = sccCounter;
-    visited[root] = true;
-    stack.push_back(root);
-
-    for (int i = 0; i < adjList[root].size(); i++) {
-        int w = adjList[root][i];
-        if (!visited[w]) {
-            getStrongConnectedComponents(w);
-            lowlink[root] = std::min(lowlink[root], lowlink[w]);
-        }
-        else if (number[w] < number[root]) {
-            if (find_vec(stack, w)) {
-                lowlink[root] = std::min(lowlink[root], number[w]);
+    /** Unblocks the given node and, transitively, the nodes waiting on it. */
+    void unblock(ID_type node) {
+        unblockList.push_back(node);
+        while (!unblockList.empty()) {
+            auto u = unblockList.back();
+            unblockList.pop_back();
+            blocked[u] = false;
+            for (auto w : B[u]) {
+                if (blocked[w])
+                    unblockList.push_back(w);
             }
+            B[u].clear();
         }
     }
 
-    if ((lowlink[root] == number[root]) && !stack.empty()) {
-        int next;
-        std::vector<int> scc;
+    const std::vector<ID_type>& nodes;
+    std::vector<std::vector<ID_type>> adjList;
+    std::vector<bool> blocked;
+    std::vector<std::vector<ID_type>> B;
+    std::vector<ID_type> stamps;
+    std::vector<ID_type> path;
+    std::vector<Frame> frames;
+    std::vector<ID_type> unblockList;
+    TarjanSearch tarjan;
+    size_t numCycles = 0;
+};
 
-        do {
-            next = stack.back();
-            stack.pop_back();
-            scc.push_back(next);
-        } while (number[next] > number[root]);
-
-        if (scc.size() > 1) {
-            currentSCCs.push_back(scc);
-        }
-    }
-}
+} // namespace
 
 /**
  * Constructor.
  *
- * Go over the node list in the Netlist object, skipping any nodes
+ * Go over the nodes of the netlist's compact graph, skipping any nodes
  * driven on edge (pos or neg), and any edges terminating on such nodes.
  *
  * @param matrix adjacency-matrix of the graph
  * @param netlist pointer to the full netlist
  */
 ElementaryCyclesSearch::ElementaryCyclesSearch(Netlist& netlist) {
-    int nodes_num = netlist.numNodes();
-    auto node_0 = netlist.getNode(0).ID;
+    auto& graph = netlist.getCompactGraph();
+    int nodes_num = graph.numNodes();
     adjList.resize(nodes_num);
     auto net_nodes = nodes_num;
     DEBUG_PRINT("Nodes: {}\n", nodes_num);
     for (size_t i = 0; i < nodes_num; i++) {
-        auto& node = netlist.getNode(i);
+        auto& node = graph.getNode(i);
         if (node.edgeKind != slang::ast::EdgeKind::None) {
             DEBUG_PRINT("skipped node {}\n", node.ID);
             net_nodes--;
             continue;
         }
-        int node_edges_num = node.getEdges().size();
-        adjList[i].clear();
-        for (int j = 0; j < node_edges_num; j++) {
-            auto& edge = *(node.getEdges()[j]);
-            if (edge.disabled)
-                continue;
-            auto& tnode = edge.getTargetNode();
+        // The compact graph only contains enabled edges.
+        for (auto succ : graph.getSuccessors(i)) {
+            auto& tnode = graph.getNode(succ);
             if (tnode.edgeKind != slang::ast::EdgeKind::None) {
                 DEBUG_PRINT("skipped tnode {}\n", tnode.ID);
                 continue;
             }
-            adjList[i].push_back(tnode.ID - node_0);
+            adjList[i].push_back(succ);
         }
     }
     DEBUG_PRINT("Actual active Nodes: {}\n", net_nodes);
 }
 
+/**
+ * Returns the strongly connected components of the graph that can contain
+ * cycles: those with more than one node, and single nodes with a self edge.
+ */
+const std::vector<std::vector<ID_type>>& ElementaryCyclesSearch::getStronglyConnectedComponents() {
+    if (componentsFound)
+        return components;
+
+    TarjanSearch tarjan(adjList.size());
+    for (ID_type i = 0; i < ID_type(adjList.size()); i++) {
+        tarjan.run(
+            i, adjList, [](ID_type) { return true; },
+            [this](ID_type, std::span<const ID_type> component) {
+                if (component.size() > 1 || find_vec(adjList[component[0]], component[0])) {
+                    auto& nodes = components.emplace_back(component.begin(), component.end());
+                    std::ranges::sort(nodes);
+                }
+            });
+    }
+
+    std::ranges::sort(components, {}, [](auto& nodes) { return nodes.front(); });
+    componentsFound = true;
+    return components;
+}
+
 /**
  * Returns List::List::Object with the Lists of nodes of all elementary
  * cycles in the graph.
  *
  * @return List::List::Object with the Lists of the elementary cycles.
  */
-std::vector<CycleListType>* ElementaryCyclesSearch::getElementaryCycles() {
-    cycles.clear();
-    blocked.resize(adjList.size(), false);
-    B.resize(adjList.size());
-    stack.clear();
-    StrongConnectedComponents sccs(adjList);
-    ID_type s = 0;
-
-    while (true) {
-        const SCCResult& sccResult = sccs.getAdjacencyList(s);
-        if (!sccResult.isEmpty() && !sccResult.getAdjList().empty()) {
-            const std::vector<std::vector<ID_type>>& scc = sccResult.getAdjList();
-            s = sccResult.getLowestNodeId();
-            for (int j = 0; j < scc.size(); j++) {
-                if (!scc[j].empty()) {
-                    blocked[j] = false;
-                    B[j].clear();
-                }
-            }
+std::vector<CycleListType>* ElementaryCyclesSearch::getElementaryCycles(
+    size_t maxCyclesPerComponent, unsigned numThreads) {
+    getStronglyConnectedComponents();
+
+    // Number the nodes of each component locally; since the components are
+    // disjoint a single table can hold the numbering for all of them.
+    std::vector<ID_type> localIds(adjList.size(), -1);
+    for (auto& nodes : components) {
+        for (size_t i = 0; i < nodes.size(); i++)
+            localIds[nodes[i]] = ID_type(i);
+    }
 
-            findCycles(s, s, scc);
-            s++;
-        }
-        else {
-            break;
+    std::vector<std::vector<CycleListType>> results(components.size());
+    std::vector<char> truncated(components.size());
+    auto searchComponents = [&](size_t start, size_t end) {
+        for (size_t i = start; i < end; i++) {
+            ComponentCycleSearch search(components[i], adjList, localIds);
+            truncated[i] = search.run(maxCyclesPerComponent, results[i]);
         }
+    };
+
+    if (numThreads != 1 && components.size() > 1) {
+        ThreadPool threadPool(numThreads);
+        threadPool.pushLoop(size_t(0), components.size(), searchComponents);
+        threadPool.waitForAll();
+    }
+    else {
+        searchComponents(0, components.size());
+    }
+
+    cycles.clear();
+    truncatedComponents.clear();
+    for (size_t i = 0; i < components.size(); i++) {
+        std::ranges::move(results[i], std::back_inserter(cycles));
+        if (truncated[i])
+            truncatedComponents.push_back(i);
     }
 
-    return &(this->cycles);
+    // Each cycle starts with its lowest node, so ordering by that matches
+    // the order in which a search of the whole graph would find them.
+    std::ranges::stable_sort(cycles, {}, [](auto& cycle) { return cycle.front(); });
+    return &cycles;
 }
 
 #ifdef DEBUG
@@ -358,71 +449,3 @@ void ElementaryCyclesSearch::dumpAdjList(Netlist& netlist) {
     }
 }
 #endif
-
-/**
- * Calculates the cycles containing a given node in a strongly connected
- * component. The method calls itself recursivly.
- *
- * @param v
- * @param s
- * @param adjList adjacency-list with the subgraph of the strongly
- * connected component s is part of.
- * @return true, if cycle found; false otherwise
- */
-bool ElementaryCyclesSearch::findCycles(ID_type v, ID_type s,
-                                        const std::vector<std::vector<ID_type>>& adjList) {
-    bool f = false;
-    stack.push_back(v);
-    blocked[v] = true;
-
-    for (int i = 0; i < adjList[v].size(); i++) {
-        ID_type w = adjList[v][i];
-
-        if (w == s) {
-            CycleListType cycle;
-            for (int j = 0; j < stack.size(); j++) {
-                ID_type index = stack[j];
-                cycle.push_back(index);
-            }
-            cycles.push_back(cycle);
-            f = true;
-        }
-        else if (!this->blocked[w]) {
-            if (this->findCycles(w, s, adjList)) {
-                f = true;
-            }
-        }
-    }
-
-    if (f) {
-        this->unblock(v);
-    }
-    else {
-        for (int i = 0; i < adjList[v].size(); i++) {
-            ID_type w = adjList[v][i];
-            if (!find_vec(B[w], v)) {
-                B[w].push_back(v);
-            }
-        }
-    }
-
-    stack.erase(remove(stack.begin(), stack.end(), v), stack.end());
-    return f;
-}
-
-/**
- * Unblocks recursivly all blocked nodes, starting with a given node.
- *
- * @param node node to unblock
- */
-void ElementaryCyclesSearch::unblock(ID_type node) {
-    this->blocked[node] = false;
-    std::vector<ID_type> Bnode = this->B[node];
-    while (!Bnode.empty()) {
-        ID_type w = Bnode.front();
-        Bnode.erase(Bnode.begin());
-        if (this->blocked[w]) {
-            this->unblock(w);
-        }
-    }
-}
@@ -3,4 +3,4 @@
 
 #include "Netlist.h"
 
-size_t netlist::NetlistNode::nextID = 0;
+std::atomic<size_t> netlist::NetlistNode::nextID = 0;
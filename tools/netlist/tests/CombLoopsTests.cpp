@@ -165,3 +165,117 @@ endmodule
               return (netlist.getNode(node).kind == NodeKind::VariableReference);
           }) == 6);
 }
+
+TEST_CASE("Combinatorial loops in separate strongly connected components") {
+    // Two independent loops, one of which goes through a self-referencing
+    // assignment, plus a chain that isn't part of any loop.
+    auto tree = SyntaxTree::fromText(R"(
+module test (input i, output o);
+wire a, b, c, d, e;
+assign a = b ^ i;
+assign b = a;
+assign c = c ^ d;
+assign d = c;
+assign e = d;
+assign o = e;
+endmodule
+)");
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+    auto netlist = createNetlist(compilation);
+    ElementaryCyclesSearch ecs(netlist);
+
+    auto& components = ecs.getStronglyConnectedComponents();
+    CHECK(components.size() == 2);
+
+    auto& cycles = *ecs.getElementaryCycles();
+    CHECK(cycles.size() == 3);
+    CHECK(ecs.getTruncatedComponents().empty());
+
+    // Every cycle should stay within a single component.
+    for (auto& cycle : cycles) {
+        auto it = std::ranges::find_if(components, [&](auto& comp) {
+            return find_vec(comp, cycle.front());
+        });
+        REQUIRE(it != components.end());
+        for (auto node : cycle)
+            CHECK(find_vec(*it, node));
+    }
+}
+
+TEST_CASE("Combinatorial loop search limit") {
+    auto tree = SyntaxTree::fromText(R"(
+module test;
+wire a, b, c;
+assign a = b | c;
+assign b = a | c;
+assign c = a | b;
+endmodule
+)");
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+    auto netlist = createNetlist(compilation);
+    ElementaryCyclesSearch ecs(netlist);
+    CHECK(ecs.getStronglyConnectedComponents().size() == 1);
+
+    auto allCycles = ecs.getElementaryCycles()->size();
+    CHECK(allCycles == 5);
+    CHECK(ecs.getTruncatedComponents().empty());
+
+    CHECK(ecs.getElementaryCycles(2, 1)->size() == 2);
+    REQUIRE(ecs.getTruncatedComponents().size() == 1);
+    CHECK(ecs.getTruncatedComponents()[0] == 0);
+
+    // Finding exactly as many cycles as the limit isn't a truncation.
+    CHECK(ecs.getElementaryCycles(5, 1)->size() == 5);
+    CHECK(ecs.getTruncatedComponents().empty());
+}
+
+TEST_CASE("Combinatorial loop search limit with a single loop") {
+    auto tree = SyntaxTree::fromText(R"(
+module test;
+wire a, b;
+assign a = b;
+assign b = a;
+endmodule
+)");
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+    auto netlist = createNetlist(compilation);
+    ElementaryCyclesSearch ecs(netlist);
+
+    CHECK(ecs.getElementaryCycles(1, 1)->size() == 1);
+    CHECK(ecs.getTruncatedComponents().empty());
+}
+
+TEST_CASE("Combinatorial loop through a self edge") {
+    auto tree = SyntaxTree::fromText(R"(
+module test;
+wire a, b;
+assign a = b;
+endmodule
+)");
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+    auto netlist = createNetlist(compilation);
+    ElementaryCyclesSearch ecs(netlist);
+    CHECK(ecs.getStronglyConnectedComponents().empty());
+    CHECK(ecs.getElementaryCycles()->empty());
+
+    // A node with an edge to itself is a component of its own that has a cycle.
+    auto* node = netlist.lookupVariable("test.a");
+    REQUIRE(node);
+    netlist.addEdge(*node, *node);
+    ElementaryCyclesSearch selfLoop(netlist);
+    auto& components = selfLoop.getStronglyConnectedComponents();
+    REQUIRE(components.size() == 1);
+    CHECK(components[0].size() == 1);
+
+    auto* cycles = selfLoop.getElementaryCycles();
+    REQUIRE(cycles->size() == 1);
+    CHECK((*cycles)[0] == components[0]);
+}
@@ -111,3 +111,63 @@ TEST_CASE("Depth-first search with an edge predicate") {
     CHECK(*visitor.nodes[1] == n2);
     CHECK(*visitor.nodes[2] == n4);
 }
+
+TEST_CASE("Depth-first search on a compact graph") {
+    DirectedGraph<TestNode, TestEdge> graph;
+    auto& n0 = graph.addNode();
+    auto& n1 = graph.addNode();
+    auto& n2 = graph.addNode();
+    auto& n3 = graph.addNode();
+    auto& n4 = graph.addNode();
+    graph.addEdge(n0, n1);
+    graph.addEdge(n0, n2);
+    graph.addEdge(n1, n3);
+    graph.addEdge(n2, n3);
+    graph.addEdge(n3, n0);
+    graph.addEdge(n3, n4);
+    CompactGraph<TestNode, TestEdge> compact(graph);
+    // The search should visit nodes and edges in the same order as a search
+    // over the graph itself.
+    TestVisitor expected;
+    DepthFirstSearch<TestNode, TestEdge, TestVisitor> dfs(expected, n2);
+    TestVisitor visitor;
+    DepthFirstSearch<TestNode, TestEdge, TestVisitor> compactDfs(visitor, compact, n2);
+    CHECK(visitor.nodes.size() == 5);
+    CHECK(visitor.nodes == expected.nodes);
+    CHECK(visitor.edges == expected.edges);
+    CHECK(*visitor.nodes[0] == n2);
+    CHECK(*visitor.nodes[1] == n3);
+    CHECK(*visitor.nodes[2] == n0);
+    CHECK(*visitor.nodes[3] == n1);
+    CHECK(*visitor.nodes[4] == n4);
+}
+
+TEST_CASE("Depth-first search on a compact graph passes node descriptors") {
+    DirectedGraph<TestNode, TestEdge> graph;
+    auto& n0 = graph.addNode();
+    auto& n1 = graph.addNode();
+    auto& n2 = graph.addNode();
+    graph.addEdge(n0, n1);
+    graph.addEdge(n1, n2);
+    graph.addEdge(n2, n0);
+    CompactGraph<TestNode, TestEdge> compact(graph);
+
+    struct DescriptorVisitor {
+        const CompactGraph<TestNode, TestEdge>& graph;
+        std::vector<std::pair<size_t, size_t>> edges;
+        void visitNode(TestNode&) {}
+        void visitEdge(TestEdge& edge, size_t source, size_t target) {
+            CHECK(&graph.getNode(source) == &edge.getSourceNode());
+            CHECK(&graph.getNode(target) == &edge.getTargetNode());
+            edges.emplace_back(source, target);
+        }
+    };
+
+    DescriptorVisitor visitor{compact, {}};
+    DepthFirstSearch<TestNode, TestEdge, DescriptorVisitor> dfs(visitor, compact, n1);
+    REQUIRE(visitor.edges.size() == 2);
+    CHECK(visitor.edges[0].first == compact.getNodeId(n1));
+    CHECK(visitor.edges[0].second == compact.getNodeId(n2));
+    CHECK(visitor.edges[1].first == compact.getNodeId(n2));
+    CHECK(visitor.edges[1].second == compact.getNodeId(n0));
+}
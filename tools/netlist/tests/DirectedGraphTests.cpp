@@ -171,3 +171,38 @@ TEST_CASE("Test iterating over nodes and node's edges") {
         CHECK(count == 0);
     }
 }
+
+TEST_CASE("Compact graph snapshot") {
+    DirectedGraph<TestNode, TestEdge> graph;
+    auto& n0 = graph.addNode();
+    auto& n1 = graph.addNode();
+    auto& n2 = graph.addNode();
+    auto& n3 = graph.addNode();
+    auto& e0 = graph.addEdge(n0, n1);
+    auto& e1 = graph.addEdge(n0, n3);
+    auto& e2 = graph.addEdge(n2, n0);
+    graph.addEdge(n3, n2);
+    CompactGraph<TestNode, TestEdge> compact(graph);
+    CHECK(compact.numNodes() == 4);
+    CHECK(compact.numEdges() == 4);
+    // Node descriptors match the positions of nodes in the graph.
+    CHECK(compact.getNodeId(n2) == 2);
+    CHECK(compact.getNode(3) == n3);
+    // Successors and edges are in the same order as in the graph.
+    auto succs = compact.getSuccessors(0);
+    REQUIRE(succs.size() == 2);
+    CHECK(succs[0] == 1);
+    CHECK(succs[1] == 3);
+    CHECK(*compact.getEdges(0)[0] == e0);
+    CHECK(*compact.getEdges(0)[1] == e1);
+    CHECK(compact.getSuccessors(1).empty());
+    CHECK(*compact.getEdges(2)[0] == e2);
+    // Edges can be filtered out of the snapshot.
+    CompactGraph<TestNode, TestEdge> filtered(
+        graph, [&](const TestEdge& edge) { return edge.getTargetNode() != n3; });
+    CHECK(filtered.numNodes() == 4);
+    CHECK(filtered.numEdges() == 3);
+    REQUIRE(filtered.getSuccessors(0).size() == 1);
+    CHECK(filtered.getSuccessors(0)[0] == 1);
+    CHECK(filtered.getSuccessors(3).size() == 1);
+}
@@ -55,3 +55,40 @@ endmodule
     auto netlist = createNetlist(compilation);
     CHECK(netlist.numNodes() > 0);
 }
+
+TEST_CASE("Node lookup by name") {
+    auto tree = SyntaxTree::fromText(R"(
+module m (input logic [1:0] a, output logic [1:0] b);
+  logic [1:0] t;
+  assign t[0] = a[0];
+  assign t[1] = a[1];
+  assign b = t;
+endmodule
+)");
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+    auto netlist = createNetlist(compilation);
+
+    auto* port = netlist.lookupPort("m.a");
+    REQUIRE(port != nullptr);
+    CHECK(port->getName() == "a");
+    CHECK(netlist.lookupPort("m.t") == nullptr);
+
+    auto* var = netlist.lookupVariable("m.t");
+    REQUIRE(var != nullptr);
+    CHECK(var->hierarchicalPath == "m.t");
+    CHECK(netlist.lookupVariable("m.x") == nullptr);
+
+    auto* ref = netlist.lookupVariableReference("t[1]");
+    REQUIRE(ref != nullptr);
+    CHECK(ref->isLeftOperand());
+    CHECK(netlist.lookupVariableReference("t[2]") == nullptr);
+
+    // Removed nodes can no longer be found.
+    CHECK(netlist.removeNode(*var));
+    CHECK(netlist.lookupVariable("m.t") == nullptr);
+    CHECK(netlist.removeNode(*ref));
+    CHECK(netlist.lookupVariableReference("t[1]") == nullptr);
+    CHECK(netlist.lookupVariableReference("t[0]") != nullptr);
+}
@@ -9,9 +9,9 @@
 
 using namespace netlist;
 
-inline Netlist createNetlist(Compilation& compilation) {
+inline Netlist createNetlist(Compilation& compilation, unsigned numThreads = 1) {
     Netlist netlist;
-    NetlistVisitor visitor(compilation, netlist);
+    NetlistVisitor visitor(compilation, netlist, numThreads);
     compilation.getRoot().visit(visitor);
     netlist.split();
     return netlist;
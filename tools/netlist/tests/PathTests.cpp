@@ -671,3 +671,76 @@ endmodule
     auto netlist = createNetlist(compilation);
     CHECK(netlist.lookupVariable("t34.i"));
 }
+
+//===---------------------------------------------------------------------===//
+// Tests for building the netlist of each instance in parallel.
+//===---------------------------------------------------------------------===//
+
+TEST_CASE("Parallel netlist construction") {
+    auto tree = SyntaxTree::fromText(R"(
+module stage #(parameter int N = 4) (input logic clk, input logic [N-1:0] i_value,
+                                     output logic [N-1:0] o_value);
+  logic [N-1:0] value;
+  always_comb begin
+    for (int i = 0; i < N; i++)
+      value[i] = i_value[N-1-i];
+  end
+  always_ff @(posedge clk)
+    o_value <= value;
+endmodule
+
+module top(input logic clk, input logic [3:0] i_value, output logic [3:0] o_value);
+  logic [3:0] values [4];
+  assign values[0] = i_value;
+  for (genvar g = 0; g < 3; g++) begin : gen
+    stage s(.clk(clk), .i_value(values[g]), .o_value(values[g+1]));
+  end
+  stage last(.clk(clk), .i_value(values[3]), .o_value(o_value));
+endmodule
+)");
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    // Describe each edge in terms of the names of the nodes it connects, since
+    // node IDs and the order of nodes differ between the two netlists.
+    auto describeEdges = [](Netlist& netlist) {
+        auto describeNode = [](NetlistNode& node) {
+            switch (node.kind) {
+                case NodeKind::PortDeclaration:
+                    return node.as<NetlistPortDeclaration>().hierarchicalPath;
+                case NodeKind::VariableDeclaration:
+                    return node.as<NetlistVariableDeclaration>().hierarchicalPath;
+                case NodeKind::VariableAlias:
+                    return "alias " + node.as<NetlistVariableAlias>().hierarchicalPath;
+                case NodeKind::VariableReference:
+                    return getSymbolHierPath(node.symbol) + " " +
+                           node.as<NetlistVariableReference>().toString();
+                default:
+                    return std::string();
+            }
+        };
+
+        std::vector<std::string> result;
+        for (auto& node : netlist) {
+            for (auto& edge : node->getEdges()) {
+                if (!edge->disabled)
+                    result.push_back(describeNode(*node) + " -> " +
+                                     describeNode(edge->getTargetNode()));
+            }
+        }
+        std::ranges::sort(result);
+        return result;
+    };
+
+    auto netlist = createNetlist(compilation);
+    auto parallelNetlist = createNetlist(compilation, 4);
+    CHECK(parallelNetlist.numNodes() == netlist.numNodes());
+    CHECK(parallelNetlist.numEdges() == netlist.numEdges());
+    CHECK(describeEdges(parallelNetlist) == describeEdges(netlist));
+
+    CHECK(parallelNetlist.lookupVariable("top.gen[1].s.value"));
+    CHECK(parallelNetlist.lookupPort("top.last.i_value"));
+    CHECK(pathExists(parallelNetlist, "top.last.i_value", "top.last.o_value") ==
+          pathExists(netlist, "top.last.i_value", "top.last.o_value"));
+}
@@ -8,10 +8,12 @@
 #pragma once
 
 #include "TidyConfig.h"
+#include "TidyDispatcher.h"
 #include "TidyFactory.h"
 #include <filesystem>
 
 #include "slang/ast/ASTVisitor.h"
+#include "slang/util/Hash.h"
 
 #define NEEDS_SKIP_SYMBOL(__symbol)                            \
     if (skip(sourceManager->getFileName((__symbol).location))) \
@@ -27,19 +29,30 @@ protected:
         config(Registry::getConfig()) {}
 
     [[nodiscard]] bool skip(std::string_view path) const {
+        // Canonicalizing the path hits the file system, so remember the result
+        // for each file rather than doing it for every symbol.
+        if (auto it = skipCache.find(path); it != skipCache.end())
+            return it->second;
+
         auto file = std::filesystem::path(path).filename().string();
         auto parentPath = weakly_canonical(std::filesystem::path(path));
         const auto& skipFiles = config.getSkipFiles();
         const auto& skipPaths = config.getSkipPaths();
-        return std::find(skipFiles.begin(), skipFiles.end(), file) != skipFiles.end() ||
-               std::find_if(skipPaths.begin(), skipPaths.end(), [&](auto& path) {
-                   return parentPath.string().find(path) != std::string::npos;
-               }) != skipPaths.end();
+        bool result = std::find(skipFiles.begin(), skipFiles.end(), file) != skipFiles.end() ||
+                      std::find_if(skipPaths.begin(), skipPaths.end(), [&](auto& path) {
+                          return parentPath.string().find(path) != std::string::npos;
+                      }) != skipPaths.end();
+        skipCache.emplace(path, result);
+        return result;
     }
 
     slang::not_null<const slang::SourceManager*> sourceManager;
     slang::Diagnostics& diags;
     const TidyConfig& config;
+
+private:
+    // File names are owned by the source manager, so they outlive the visitor.
+    mutable slang::flat_hash_map<std::string_view, bool> skipCache;
 };
 
 /// ASTVisitor that will collect all identifiers under a node
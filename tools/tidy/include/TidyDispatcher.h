@@ -0,0 +1,245 @@
+//------------------------------------------------------------------------------
+//! @file TidyDispatcher.h
+//! @brief Runs the AST visitors of several checks in a single traversal
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "slang/ast/ASTVisitor.h"
+#include "slang/util/SmallVector.h"
+
+/// Runs the AST visitors of several checks together in a single traversal of the AST,
+/// instead of having each of them walk the whole design on its own.
+///
+/// Each visitor is passed exactly the nodes it would see if it traversed the AST by
+/// itself: as with ASTVisitor, the nodes below one that the visitor has a handler for
+/// are hidden from it, as are statements and expressions unless its ASTVisitor base
+/// asks for them. Subtrees that are hidden from every visitor are not traversed at all.
+class TidyDispatcher : public slang::ast::ASTVisitor<TidyDispatcher, true, true> {
+public:
+    /// Creates a dispatcher. If @a timeHandlers is set, the time spent in the
+    /// handlers of each visitor is measured; see getHandlerTime.
+    explicit TidyDispatcher(bool timeHandlers = false) : timeHandlers(timeHandlers) {}
+
+    /// Creates a visitor of type @a TVisitor from @a args and adds it to the dispatcher.
+    template<typename TVisitor, typename... Args>
+    void add(Args&&... args) {
+        if (timeHandlers) {
+            visitors.push_back(
+                std::make_unique<Visitor<TVisitor, true>>(std::forward<Args>(args)...));
+        }
+        else {
+            visitors.push_back(
+                std::make_unique<Visitor<TVisitor, false>>(std::forward<Args>(args)...));
+        }
+        numVisible++;
+    }
+
+    /// Gets the number of visitors that have been added to the dispatcher.
+    size_t getNumVisitors() const { return visitors.size(); }
+
+    /// Gets the total time spent in the handlers of the visitor at @a index,
+    /// in the order the visitors were added. This is always zero unless the
+    /// dispatcher was created with handler timing enabled.
+    std::chrono::nanoseconds getHandlerTime(size_t index) const {
+        return visitors[index]->handlerTime;
+    }
+
+    template<typename T>
+    void handle(const T& node) {
+        // Give the node to each visitor that can see it; the ones that have a
+        // handler for it don't see anything below it.
+        slang::SmallVector<VisitorBase*> handledBy;
+        for (auto& visitor : visitors) {
+            if (!visitor->hidden && dispatch(*visitor, node)) {
+                hide(*visitor);
+                handledBy.push_back(visitor.get());
+            }
+        }
+
+        if (numVisible)
+            visitChildren(node);
+
+        for (auto visitor : handledBy)
+            show(*visitor);
+    }
+
+private:
+    struct VisitorBase {
+        const bool visitStatements;
+        const bool visitExpressions;
+
+        // The number of enclosing subtrees that are hidden from this visitor.
+        uint32_t hidden = 0;
+
+        std::chrono::nanoseconds handlerTime{};
+
+        VisitorBase(bool visitStatements, bool visitExpressions) :
+            visitStatements(visitStatements), visitExpressions(visitExpressions) {}
+        virtual ~VisitorBase() = default;
+
+        // Each of these passes the node to the visitor's handler for its concrete
+        // type, returning false if the visitor doesn't have one.
+        virtual bool handle(const slang::ast::Symbol& node) = 0;
+        virtual bool handle(const slang::ast::Statement& node) = 0;
+        virtual bool handle(const slang::ast::Expression& node) = 0;
+        virtual bool handle(const slang::ast::TimingControl& node) = 0;
+        virtual bool handle(const slang::ast::Constraint& node) = 0;
+        virtual bool handle(const slang::ast::AssertionExpr& node) = 0;
+        virtual bool handle(const slang::ast::BinsSelectExpr& node) = 0;
+        virtual bool handle(const slang::ast::Pattern& node) = 0;
+    };
+
+    template<typename TDerived, bool VisitStatements, bool VisitExpressions, bool VisitBad>
+    static constexpr auto getVisitorFlags(
+        const slang::ast::ASTVisitor<TDerived, VisitStatements, VisitExpressions, VisitBad>*) {
+        static_assert(!VisitBad, "visitors of invalid nodes are not supported");
+        return std::pair{VisitStatements, VisitExpressions};
+    }
+
+    template<typename TVisitor, bool Timed>
+    struct Visitor : public VisitorBase {
+        static constexpr auto flags = getVisitorFlags(static_cast<TVisitor*>(nullptr));
+
+        TVisitor visitor;
+
+        template<typename... Args>
+        explicit Visitor(Args&&... args) :
+            VisitorBase(flags.first, flags.second), visitor(std::forward<Args>(args)...) {}
+
+        bool handle(const slang::ast::Symbol& node) override { return dispatch(node); }
+        bool handle(const slang::ast::Statement& node) override { return dispatch(node); }
+        bool handle(const slang::ast::Expression& node) override { return dispatch(node); }
+        bool handle(const slang::ast::TimingControl& node) override { return dispatch(node); }
+        bool handle(const slang::ast::Constraint& node) override { return dispatch(node); }
+        bool handle(const slang::ast::AssertionExpr& node) override { return dispatch(node); }
+        bool handle(const slang::ast::BinsSelectExpr& node) override { return dispatch(node); }
+        bool handle(const slang::ast::Pattern& node) override { return dispatch(node); }
+
+    private:
+        // Recovers the concrete type of a node, the same way the AST does when
+        // visiting it, and calls the visitor's handler for that type if it has one.
+        struct Caller {
+            Visitor& self;
+            bool handled = false;
+
+            template<typename T>
+            void visit(const T& node) {
+                if constexpr (requires { self.visitor.handle(node); }) {
+                    if constexpr (Timed) {
+                        auto start = std::chrono::steady_clock::now();
+                        self.visitor.handle(node);
+                        self.handlerTime += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start);
+                    }
+                    else {
+                        self.visitor.handle(node);
+                    }
+                    handled = true;
+                }
+            }
+        };
+
+        template<typename TNode>
+        bool dispatch(const TNode& node) {
+            Caller caller{*this};
+            node.visit(caller);
+            return caller.handled;
+        }
+    };
+
+    template<typename T>
+    static bool dispatch(VisitorBase& visitor, const T& node) {
+        using namespace slang::ast;
+        if constexpr (std::is_base_of_v<Symbol, T>)
+            return visitor.handle(static_cast<const Symbol&>(node));
+        else if constexpr (std::is_base_of_v<Statement, T>)
+            return visitor.handle(static_cast<const Statement&>(node));
+        else if constexpr (std::is_base_of_v<Expression, T>)
+            return visitor.handle(static_cast<const Expression&>(node));
+        else if constexpr (std::is_base_of_v<TimingControl, T>)
+            return visitor.handle(static_cast<const TimingControl&>(node));
+        else if constexpr (std::is_base_of_v<Constraint, T>)
+            return visitor.handle(static_cast<const Constraint&>(node));
+        else if constexpr (std::is_base_of_v<AssertionExpr, T>)
+            return visitor.handle(static_cast<const AssertionExpr&>(node));
+        else if constexpr (std::is_base_of_v<BinsSelectExpr, T>)
+            return visitor.handle(static_cast<const BinsSelectExpr&>(node));
+        else if constexpr (std::is_base_of_v<Pattern, T>)
+            return visitor.handle(static_cast<const Pattern&>(node));
+        else
+            return false;
+    }
+
+    void hide(VisitorBase& visitor) {
+        if (visitor.hidden++ == 0)
+            numVisible--;
+    }
+
+    void show(VisitorBase& visitor) {
+        if (--visitor.hidden == 0)
+            numVisible++;
+    }
+
+    // Hides the subtree visited by @a func from the visitors that don't want
+    // to see statements (or expressions, if @a expressions is set).
+    template<typename TFunc>
+    void visitHidingFrom(bool expressions, TFunc&& func) {
+        slang::SmallVector<VisitorBase*> hiddenFrom;
+        for (auto& visitor : visitors) {
+            if (!(expressions ? visitor->visitExpressions : visitor->visitStatements)) {
+                hide(*visitor);
+                hiddenFrom.push_back(visitor.get());
+            }
+        }
+
+        if (numVisible)
+            func();
+
+        for (auto visitor : hiddenFrom)
+            show(*visitor);
+    }
+
+    // Mirrors ASTVisitor::visitDefault, but with statements and expressions
+    // hidden from the visitors that haven't asked for them.
+    template<typename T>
+    void visitChildren(const T& node) {
+        using namespace slang::ast;
+        if constexpr (HasVisitExprs<T, TidyDispatcher>)
+            visitHidingFrom(true, [&] { node.visitExprs(*this); });
+
+        if constexpr (requires { node.visitStmts(*this); })
+            visitHidingFrom(false, [&] { node.visitStmts(*this); });
+
+        if constexpr (std::is_base_of_v<Symbol, T>) {
+            if (auto declaredType = node.getDeclaredType()) {
+                if (auto init = declaredType->getInitializer())
+                    visitHidingFrom(true, [&] { init->visit(*this); });
+            }
+        }
+
+        if constexpr (std::is_base_of_v<Scope, T>) {
+            for (auto& member : node.members())
+                member.visit(*this);
+        }
+
+        if constexpr (std::is_same_v<InstanceSymbol, T> ||
+                      std::is_same_v<CheckerInstanceSymbol, T>) {
+            node.body.visit(*this);
+        }
+    }
+
+    std::vector<std::unique_ptr<VisitorBase>> visitors;
+    bool timeHandlers;
+
+    // The number of visitors that can see the current node.
+    size_t numVisible = 0;
+};
@@ -20,6 +20,7 @@
 #include "slang/util/Util.h"
 
 class TidyCheck;
+class TidyDispatcher;
 
 class Registry {
 public:
@@ -101,6 +102,12 @@ public:
     /// Returns true if the check didn't find any errors, false otherwise
     [[nodiscard]] virtual bool check(const slang::ast::RootSymbol& root) = 0;
 
+    /// Adds the AST visitor of this check to the dispatcher, so that it runs as part of
+    /// a single traversal of the AST shared with the other checks. Its results are then
+    /// available from getDiagnostics(). Returns false if the check doesn't support this,
+    /// in which case it has to be run on its own with check().
+    virtual bool addVisitor(TidyDispatcher&) { return false; }
+
     virtual std::string name() const = 0;
     virtual std::string description() const = 0;
     virtual std::string shortDescription() const = 0;
@@ -45,6 +45,11 @@ public:
         return true;
     }
 
+    bool addVisitor(TidyDispatcher& dispatcher) override {
+        dispatcher.add<MainVisitor>(diagnostics);
+        return true;
+    }
+
     DiagCode diagCode() const override { return diag::AlwaysCombNonBlocking; }
     DiagnosticSeverity diagSeverity() const override { return DiagnosticSeverity::Warning; }
     std::string diagString() const override {
@@ -43,6 +43,11 @@ public:
         return true;
     }
 
+    bool addVisitor(TidyDispatcher& dispatcher) override {
+        dispatcher.add<MainVisitor>(diagnostics);
+        return true;
+    }
+
     DiagCode diagCode() const override { return diag::EnforceModuleInstantiationPrefix; }
     DiagnosticSeverity diagSeverity() const override { return DiagnosticSeverity::Warning; }
     std::string diagString() const override {
@@ -66,6 +66,11 @@ public:
         return true;
     }
 
+    bool addVisitor(TidyDispatcher& dispatcher) override {
+        dispatcher.add<MainVisitor>(diagnostics);
+        return true;
+    }
+
     DiagCode diagCode() const override { return diag::EnforcePortSuffix; }
     DiagnosticSeverity diagSeverity() const override { return DiagnosticSeverity::Warning; }
     std::string diagString() const override {
@@ -47,6 +47,11 @@ public:
         return true;
     }
 
+    bool addVisitor(TidyDispatcher& dispatcher) override {
+        dispatcher.add<MainVisitor>(diagnostics);
+        return true;
+    }
+
     DiagCode diagCode() const override { return diag::NoDotStarInPortConnection; }
 
     std::string diagString() const override { return "use of .* in port connection list"; }
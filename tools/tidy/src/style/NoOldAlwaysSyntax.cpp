@@ -53,6 +53,11 @@ public:
         return true;
     }
 
+    bool addVisitor(TidyDispatcher& dispatcher) override {
+        dispatcher.add<MainVisitor>(diagnostics);
+        return true;
+    }
+
     DiagCode diagCode() const override { return diag::NoOldAlwaysSyntax; }
 
     std::string diagString() const override { return "use of old always verilog syntax"; }
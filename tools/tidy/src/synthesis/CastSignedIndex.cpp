@@ -34,6 +34,11 @@ public:
         return diagnostics.empty();
     }
 
+    bool addVisitor(TidyDispatcher& dispatcher) override {
+        dispatcher.add<MainVisitor>(diagnostics);
+        return true;
+    }
+
     DiagCode diagCode() const override { return diag::CastSignedIndex; }
 
     std::string diagString() const override {
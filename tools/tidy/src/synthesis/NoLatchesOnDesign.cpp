@@ -42,6 +42,11 @@ public:
         return true;
     }
 
+    bool addVisitor(TidyDispatcher& dispatcher) override {
+        dispatcher.add<MainVisitor>(diagnostics);
+        return true;
+    }
+
     DiagCode diagCode() const override { return diag::NoLatchesOnDesign; }
 
     std::string diagString() const override { return "latches are not allowed in this design"; }
@@ -94,6 +94,11 @@ public:
         return true;
     }
 
+    bool addVisitor(TidyDispatcher& dispatcher) override {
+        dispatcher.add<MainVisitor>(diagnostics);
+        return true;
+    }
+
     DiagCode diagCode() const override { return diag::OnlyAssignedOnReset; }
 
     std::string diagString() const override { return "register '{}' is only assigned on reset"; }
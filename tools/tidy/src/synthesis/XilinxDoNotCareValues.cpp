@@ -39,6 +39,11 @@ public:
         return diagnostics.empty();
     }
 
+    bool addVisitor(TidyDispatcher& dispatcher) override {
+        dispatcher.add<MainVisitor>(diagnostics);
+        return true;
+    }
+
     DiagCode diagCode() const override { return diag::XilinxDoNotCareValues; }
 
     std::string diagString() const override {
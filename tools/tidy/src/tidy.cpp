@@ -7,15 +7,18 @@
 //------------------------------------------------------------------------------
 
 #include "TidyConfigParser.h"
+#include "TidyDispatcher.h"
 #include "TidyFactory.h"
 #include "fmt/color.h"
 #include "fmt/format.h"
+#include <chrono>
 #include <filesystem>
 #include <unordered_set>
 
 #include "slang/ast/Compilation.h"
 #include "slang/diagnostics/TextDiagnosticClient.h"
 #include "slang/driver/Driver.h"
+#include "slang/util/ThreadPool.h"
 #include "slang/util/VersionInfo.h"
 
 /// Performs a search for the .slang-tidy file on the current directory. If the file is not found,
@@ -23,6 +26,10 @@
 std::optional<std::filesystem::path> project_slang_tidy_config();
 using namespace slang;
 
+/// Visits every node in the AST, including the contents of uninstantiated generate
+/// blocks that elaboration skips, so that any lazily bound state has been created.
+struct BindAllVisitor : public ast::ASTVisitor<BindAllVisitor, true, true> {};
+
 int main(int argc, char** argv) {
     OS::setupConsole();
 
@@ -45,6 +52,12 @@ int main(int argc, char** argv) {
     driver.cmdLine.add("--config-file", tidyConfigFile,
                        "Path to where the tidy config file is located");
 
+    std::optional<bool> printTiming;
+    driver.cmdLine.add("--print-timing", printTiming,
+                       "Print the time spent running each check. For checks that run together "
+                       "in a single traversal of the AST, this is the time spent in the check's "
+                       "own handlers");
+
     std::vector<std::string> skippedFiles;
     driver.cmdLine.add("--skip-file", skippedFiles, "Files to be skipped by slang-tidy");
 
@@ -139,28 +152,95 @@ int main(int argc, char** argv) {
     // Set the sourceManager to the Registry so checks can access it
     Registry::setSourceManager(compilation->getSourceManager());
 
-    int retCode = 0;
+    // Create all enabled checks. The ones that support it are split into one group per
+    // thread, and the checks in each group run together in a single traversal of the
+    // AST. The others each run on their own.
+    struct CheckRun {
+        std::unique_ptr<TidyCheck> check;
+        TidyDispatcher* dispatcher = nullptr;
+        size_t visitorIndex = 0;
+        bool ok = true;
+        std::chrono::nanoseconds elapsed{};
+    };
 
-    // Check all enabled checks
+    std::vector<CheckRun> runs;
+    ThreadPool threadPool(driver.options.numThreads.value_or(0));
+    std::vector<TidyDispatcher> dispatchers;
+    dispatchers.reserve(threadPool.getThreadCount());
+    for (size_t i = 0; i < threadPool.getThreadCount(); i++)
+        dispatchers.emplace_back(printTiming == true);
+    size_t numDispatched = 0;
     for (const auto& checkName : Registry::getEnabledChecks()) {
-        const auto check = Registry::create(checkName);
+        auto& run = runs.emplace_back();
+        run.check = Registry::create(checkName);
+
+        auto& dispatcher = dispatchers[numDispatched % dispatchers.size()];
+        run.visitorIndex = dispatcher.getNumVisitors();
+        if (run.check->addVisitor(dispatcher)) {
+            run.dispatcher = &dispatcher;
+            numDispatched++;
+        }
+    }
+
+    // Elaboration doesn't bind the members of uninstantiated generate blocks, but the
+    // checks visit them, and binding isn't thread safe. Bind everything up front so
+    // that the checks running in parallel only ever read from the compilation.
+    auto& root = compilation->getRoot();
+    if (threadPool.getThreadCount() > 1) {
+        BindAllVisitor visitor;
+        root.visit(visitor);
+    }
+
+    for (auto& dispatcher : dispatchers) {
+        if (dispatcher.getNumVisitors())
+            threadPool.pushTask([&root, &dispatcher] { root.visit(dispatcher); });
+    }
+
+    for (auto& run : runs) {
+        if (!run.dispatcher) {
+            threadPool.pushTask([&root, &run] {
+                auto start = std::chrono::steady_clock::now();
+                run.ok = run.check->check(root);
+                run.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start);
+            });
+        }
+    }
+    threadPool.waitForAll();
+
+    int retCode = 0;
+
+    // Report the results of all enabled checks, in order.
+    for (auto& run : runs) {
+        auto& check = run.check;
+        if (run.dispatcher) {
+            run.ok = check->getDiagnostics().empty();
+            run.elapsed = run.dispatcher->getHandlerTime(run.visitorIndex);
+        }
+
         OS::print(fmt::format("[{}]", check->name()));
 
         driver.diagEngine.setMessage(check->diagCode(), check->diagString());
         driver.diagEngine.setSeverity(check->diagCode(), check->diagSeverity());
 
-        auto checkOk = check->check(compilation->getRoot());
-        if (!checkOk) {
+        if (!run.ok) {
             retCode = 1;
-            OS::print(fmt::emphasis::bold | fmt::fg(fmt::color::red), " FAIL\n");
+            OS::print(fmt::emphasis::bold | fmt::fg(fmt::color::red), " FAIL");
+        }
+        else {
+            OS::print(fmt::emphasis::bold | fmt::fg(fmt::color::green), " PASS");
+        }
+
+        if (printTiming == true)
+            OS::print(fmt::format(" ({:.3f} ms)", run.elapsed.count() / 1e6));
+        OS::print("\n");
+
+        if (!run.ok) {
             for (const auto& diag : check->getDiagnostics())
                 driver.diagEngine.issue(diag);
             OS::print(fmt::format("{}\n", driver.diagClient->getString()));
             driver.diagClient->clear();
         }
-        else {
-            OS::print(fmt::emphasis::bold | fmt::fg(fmt::color::green), " PASS\n");
-        }
     }
 
     return retCode;
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+
+#include "Test.h"
+#include "TidyDispatcher.h"
+#include "TidyFactory.h"
+
+TEST_CASE("TidyDispatcher: Same results as running each check on its own") {
+    auto tree = SyntaxTree::fromText(R"(
+module leaf(input logic [3:0] a);
+endmodule
+
+module sub(input logic clk, input logic rst, input logic [3:0] a, output logic [3:0] b);
+    leaf l(.a);
+    logic [3:0] arr [4];
+    logic [3:0] latch;
+
+    always_ff @(posedge clk) begin
+        if (rst)
+            b <= '0;
+        else
+            b = a;
+    end
+
+    always_comb begin
+        arr[2'(a)] <= a;
+        if (a[0])
+            latch = 4'bx01?;
+    end
+
+    always @(*) begin
+        arr[0] = a;
+    end
+endmodule
+
+module top(input logic clk, input logic rst, input logic [3:0] in, output logic [3:0] out);
+    logic [3:0] a, b;
+    sub s1(.*);
+    sub s2(.clk, .rst(rst), .a(in), .b(out));
+    for (genvar i = 0; i < 2; i++) begin : gen
+        sub s(.clk(clk), .rst(rst), .a(in), .b());
+    end
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    compilation.getAllDiagnostics();
+    auto& root = compilation.getRoot();
+
+    TidyConfig config;
+    Registry::setConfig(config);
+    Registry::setSourceManager(compilation.getSourceManager());
+
+    std::vector<std::pair<std::unique_ptr<TidyCheck>, std::unique_ptr<TidyCheck>>> checks;
+    TidyDispatcher dispatcher(true);
+    for (auto& name : Registry::getRegisteredChecks()) {
+        auto separate = Registry::create(name);
+        auto dispatched = Registry::create(name);
+        (void)separate->check(root);
+        CHECK(dispatched->addVisitor(dispatcher));
+        checks.emplace_back(std::move(separate), std::move(dispatched));
+    }
+    root.visit(dispatcher);
+    REQUIRE(dispatcher.getNumVisitors() == checks.size());
+
+    size_t total = 0;
+    for (size_t index = 0; index < checks.size(); index++) {
+        auto& [separate, dispatched] = checks[index];
+        INFO(separate->name());
+        auto& expected = separate->getDiagnostics();
+        auto& actual = dispatched->getDiagnostics();
+        REQUIRE(actual.size() == expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            CHECK(actual[i].code == expected[i].code);
+            CHECK(actual[i].location == expected[i].location);
+        }
+        total += expected.size();
+
+        // Every check that reported something must have spent time in its handlers.
+        if (!expected.empty())
+            CHECK(dispatcher.getHandlerTime(index).count() > 0);
+    }
+    CHECK(total > 5);
+}